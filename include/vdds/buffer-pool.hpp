@@ -0,0 +1,166 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_BUFFER_POOL_HPP
+#define VDDS_BUFFER_POOL_HPP
+
+#include <stdint.h>
+#include <string>
+#include <atomic>
+#include <memory>
+
+#include <hogl/area.hpp>
+
+#include "detail/free-list.hpp"
+#include "detail/placement.hpp"
+#include "detail/aligned.hpp"
+#include "shared.hpp"
+#include "query.hpp"
+
+namespace vdds {
+
+class domain;
+
+/// Buffer pool for shared payloads.
+/// Fixed number of fixed-size buffers carved out of a single memory region.
+/// Buffers are intrusively refcounted payloads (@see vdds::intrusive_t) and are returned
+/// to the pool automatically when the last reference is dropped (typically by the last
+/// subscriber). Each thread that gets buffers keeps a small cache of free buffers in front
+/// of the lock-free global free list. Threads that only release buffers return them straight
+/// to the global list. The pool is registered with the domain, stats are reported through
+/// vdds::domain::query.
+class buffer_pool {
+public:
+	/// Pooled buffer
+	struct buffer : intrusive_t {
+		uint8_t*     data; ///< buffer data
+		size_t       size; ///< buffer size
+		buffer_pool* pool; ///< owner pool
+		uint32_t     id;   ///< buffer index in the pool
+
+		buffer() : data(nullptr), size(0), pool(nullptr), id(0) {}
+
+		/// Return the buffer to the pool
+		void dispose() noexcept override { pool->put(this); }
+	};
+
+	/// Per-thread cache of free buffers
+	struct alignas(64) thread_cache : detail::aligned_new<thread_cache> {
+		std::atomic<bool>     in_use; ///< cache is owned by a thread
+		uint32_t              count;  ///< number of cached buffers
+		std::unique_ptr<uint32_t[]> ids; ///< cached buffer indices
+		std::atomic<uint64_t> hits;   ///< number of get ops served from the cache
+		std::atomic<uint64_t> misses; ///< number of get ops served from the global list
+		thread_cache*         next;   ///< next cache in the pool list
+	};
+
+private:
+	domain&     _domain;    ///> owner domain
+	std::string _name;      ///> pool name
+	size_t      _count;     ///> number of buffers
+	size_t      _size;      ///> buffer size
+	size_t      _stride;    ///> distance between the buffers (size rounded to the cacheline)
+	uint64_t    _id;        ///> unique pool id (thread cache lookup)
+	hogl::area* _area;      ///> log area
+
+	void*       _mem;       ///> buffer memory
+	detail::placement _placement; ///> buffer memory placement
+	bool        _huge;      ///> memory is backed by hugepages
+
+	std::unique_ptr<buffer[]> _bufs;     ///> buffer descriptors
+	detail::free_list         _free;     ///> global list of free buffers
+	uint32_t                  _cache_size; ///> max number of buffers cached per thread (0 - disabled)
+	std::atomic<thread_cache*> _caches;  ///> list of thread caches
+	std::atomic<uint64_t>     _exhausted; ///> number of failed get ops (pool was empty)
+	std::atomic<uint64_t>     _misses;    ///> number of get ops without thread cache (caching disabled)
+
+	/// Get the calling thread's cache.
+	/// @param[in] create allocate the cache if the thread does not have one yet
+	/// @return cache pointer (null if caching is disabled or the thread has no cache)
+	thread_cache* local(bool create);
+
+	/// Release the thread cache (thread exit)
+	void detach(thread_cache* tc);
+
+	/// Return buffer to the pool
+	void put(buffer* b) noexcept;
+
+	friend struct buffer;
+	friend struct pool_tls;
+
+public:
+	/// Create buffer pool.
+	/// Hugepage backing uses explicit hugepages if available, and falls back to
+	/// transparent hugepages otherwise.
+	/// @param[in] vd reference to the domain
+	/// @param[in] name pool name
+	/// @param[in] count number of buffers
+	/// @param[in] size buffer size
+	/// @param[in] hugepages back the buffers with hugepages
+	explicit buffer_pool(domain& vd, const std::string& name, size_t count, size_t size, bool hugepages = false);
+
+	/// Delete buffer pool.
+	/// All buffers must be returned to the pool before this call.
+	~buffer_pool();
+
+	// No copies
+	buffer_pool(const buffer_pool&) = delete;
+	buffer_pool& operator=(const buffer_pool&) = delete;
+
+	/// Get pool name
+	const std::string& name() const { return _name; }
+
+	/// Get number of buffers and buffer size
+	size_t count() const { return _count; }
+	size_t buffer_size() const { return _size; }
+
+	/// Check if the pool is backed by explicit hugepages
+	bool hugepages() const { return _huge; }
+
+	/// Get buffer.
+	/// Lockfree and nonblocking.
+	/// @return handle to the buffer, or null handle if the pool is exhausted
+	shared_handle get();
+
+	/// Get buffer pointer from the handle
+	/// @param h shared data handle holding a pooled buffer
+	static buffer* from(const shared_handle& h) { return static_cast<buffer*>(h.get()); }
+
+	/// Query pool info & stats
+	/// @param[out] i pool info
+	void query(query::pool_info& i);
+
+	/// Dump pool info & stats into debug log
+	void dump();
+};
+
+} // namespace vdds
+
+#endif // VDDS_BUFFER_POOL_HPP
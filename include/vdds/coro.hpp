@@ -0,0 +1,260 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_CORO_HPP
+#define VDDS_CORO_HPP
+
+#ifdef VDDS_WITH_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+#include <atomic>
+#include <chrono>
+
+#include "notifier.hpp"
+#include "waitset.hpp"
+
+namespace vdds {
+
+template<typename T> class sub;
+
+/// C++20 coroutine support (opt-in, WITH_COROUTINES build option).
+/// Subscribers attached to a coroutine scheduler can be awaited with co_await sub.next().
+/// The awaiting coroutine is suspended until the data arrives and resumed by the scheduler
+/// thread. Multi-input pipeline stages can be written as straight-line code and many stages
+/// share one thread.
+namespace coro {
+
+class scheduler;
+
+/// Coroutine task.
+/// Fire-and-forget: starts right away on the calling thread, which must be the scheduler
+/// thread (@see scheduler). Frame is released when the coroutine returns.
+/// Exceptions are fatal.
+struct task {
+	struct promise_type {
+		task get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+/// Suspended coroutine waiting for data
+struct waiter {
+	std::coroutine_handle<> handle; ///< coroutine to resume
+
+	/// Try to pop the data the coroutine is waiting for
+	virtual bool try_pop() = 0;
+
+protected:
+	~waiter() = default;
+};
+
+/// Scheduler member.
+/// Notifier for one subscriber queue.
+class member : public notifier {
+private:
+	scheduler&       _sched; ///> owner scheduler
+	waitset::member* _wm;    ///> waitset member
+
+public:
+	member(scheduler& s, waitset::member* wm) : notifier("coro"), _sched(s), _wm(wm) {}
+
+	/// Get owner scheduler
+	scheduler& sched() { return _sched; }
+
+	/// Get member id
+	unsigned int id() const { return _wm->id(); }
+
+	void wait_for(std::chrono::nanoseconds t) override { _wm->wait_for(t); }
+	void notify() override { _wm->notify(); }
+	void shutdown(std::chrono::nanoseconds t) override { _wm->shutdown(t); }
+};
+
+/// Coroutine scheduler.
+/// Resumes the coroutines waiting for the subscriber queues that have data.
+/// Subscribers are attached to the scheduler at construction (@see vdds::sub).
+/// Single-threaded: the coroutines run on the thread that calls run() or poll(), and must be
+/// started on that thread too (the first suspension registers the coroutine without locking).
+class scheduler {
+private:
+	waitset _ws;                                   ///> ready subscriber queues
+	waitset::member* _wakeup;                      ///> wakes up the scheduler on stop (not a subscriber)
+	std::vector<std::unique_ptr<member>> _members; ///> member notifiers
+	std::vector<member*>      _free;               ///> removed members (reused by add)
+	std::vector<waiter*>      _waiting;            ///> suspended coroutines by member id
+	std::vector<unsigned int> _ready;              ///> ready member ids (poll scratch)
+	std::atomic<bool>         _stop;               ///> stop requested
+
+public:
+	/// Create scheduler
+	/// @param capacity max number of subscriber queues (at least 1)
+	explicit scheduler(unsigned int capacity = 64) :
+		_ws(capacity + 1), _wakeup(nullptr), _waiting(capacity + 1, nullptr), _stop(false)
+	{
+		if (!capacity)
+			throw std::invalid_argument("coroutine scheduler capacity must be non-zero");
+		_members.reserve(capacity);
+		_free.reserve(capacity);
+
+		// Dedicated member, stop() never looks like data for a subscriber
+		_wakeup = _ws.add();
+	}
+
+	/// Destroy scheduler.
+	/// Coroutines that are still suspended are destroyed.
+	~scheduler()
+	{
+		for (auto w : _waiting)
+			if (w) w->handle.destroy();
+	}
+
+	// No copies
+	scheduler(const scheduler&) = delete;
+	scheduler& operator=(const scheduler&) = delete;
+
+	/// Add member.
+	/// Called by the subscribers attached to the scheduler.
+	/// Must not be called concurrently with run() or poll().
+	/// @return notifier for the subscriber queue
+	member* add()
+	{
+		if (!_free.empty()) {
+			member* m = _free.back();
+			_free.pop_back();
+			return m;
+		}
+
+		auto wm = _ws.add();
+		if (!wm)
+			throw std::length_error("coroutine scheduler is full");
+		_members.emplace_back(new member(*this, wm));
+		return _members.back().get();
+	}
+
+	/// Remove member.
+	/// Called by the subscribers attached to the scheduler, once the queue is unsubscribed
+	/// (the notifier is no longer used). The member is reused by the next add().
+	/// A coroutine still waiting for the member is dropped, it is never resumed.
+	/// Must not be called concurrently with run() or poll().
+	/// @param m member returned by add()
+	void remove(member* m) noexcept
+	{
+		_waiting[m->id()] = nullptr;
+		_free.push_back(m);
+	}
+
+	/// Register suspended coroutine (called from the awaiters).
+	/// Runs on the scheduler thread (@see scheduler).
+	/// Throws std::logic_error if another coroutine is already waiting for the member.
+	void suspend(unsigned int id, waiter* w)
+	{
+		if (_waiting[id])
+			throw std::logic_error("coroutine scheduler member already has a waiting coroutine");
+		_waiting[id] = w;
+
+		// Data may be already there, the ready bit was consumed
+		_ws.mark(id);
+	}
+
+	/// Resume the coroutines that have data.
+	/// @param t max time to wait for the data
+	/// @return number of resumed coroutines
+	size_t poll(std::chrono::nanoseconds t = std::chrono::milliseconds(1))
+	{
+		size_t n = 0;
+		_ws.wait(_ready, t);
+		for (auto id : _ready) {
+			// Stop wakeup has no waiter
+			waiter* w = _waiting[id];
+			if (!w || !w->try_pop()) continue;
+			_waiting[id] = nullptr;
+			w->handle.resume();
+			n++;
+		}
+		return n;
+	}
+
+	/// Run the scheduler until stop()
+	void run()
+	{
+		while (!_stop.load(std::memory_order_acquire))
+			poll(std::chrono::milliseconds(10));
+		_stop.store(false, std::memory_order_relaxed);
+	}
+
+	/// Stop the scheduler.
+	/// Can be called from the coroutines and from the other threads.
+	void stop()
+	{
+		_stop.store(true, std::memory_order_release);
+		_wakeup->notify();
+	}
+};
+
+/// Awaitable pop.
+/// Returned by vdds::sub::next(). Completes right away if the queue has data, otherwise the
+/// coroutine is suspended until the scheduler sees the data.
+/// @param T data type
+template<typename T>
+class next_awaiter : private waiter {
+private:
+	sub<T>& _sub;   ///> subscriber
+	member* _m;     ///> scheduler member of the subscriber queue
+	T       _data;  ///> popped data
+
+	bool try_pop() override { return _sub.pop(_data); }
+
+public:
+	/// @param s subscriber
+	/// @param m scheduler member of the subscriber (@see vdds::sub::next)
+	next_awaiter(sub<T>& s, member* m) : _sub(s), _m(m) {}
+
+	bool await_ready() { return try_pop(); }
+
+	void await_suspend(std::coroutine_handle<> h)
+	{
+		this->handle = h;
+		_m->sched().suspend(_m->id(), this);
+	}
+
+	T await_resume() { return std::move(_data); }
+};
+
+} // namespace coro
+} // namespace vdds
+
+#endif // VDDS_WITH_COROUTINES
+
+#endif // VDDS_CORO_HPP
@@ -36,31 +36,104 @@
 #include <stdint.h>
 #include <memory>
 #include <array>
+#include <type_traits>
 
-namespace vdds {
+#include "shared.hpp"
 
-/// Base data type for PubSub operations.
-/// User-defined types shall be derived from this type.
-/// Sized to be exactly 256 bytes (4 cachelines on most CPUs).
-struct data {
-	/// Generic shared data type used with std::shared_ptr
-	struct shared_t {
-		virtual ~shared_t() { };
-	};
+namespace vdds {
 
-	using shared_p = std::shared_ptr<shared_t>;
+/// Plain data header.
+/// Common part of all data types (@see vdds::basic_data, vdds::plain_data).
+struct plain_header {
 	using seqno_t  = uint64_t;
 	using timestamp_t = uint64_t;
 
-	// Generic plain data type used for small payload
-	using plain_t = std::array<uint8_t, 256 - sizeof(seqno_t) - sizeof(timestamp_t) - sizeof(shared_p)>;
-
 	seqno_t     seqno;     ///< Sequence number set by vDDS publish operation.
 	timestamp_t timestamp; ///< Timestamp in nanoseconds (userdefined timebase).
+};
+
+/// Data header.
+/// Common part of all data size classes with shared payload (@see vdds::basic_data).
+/// The shared payload is a vdds::shared_handle (std::shared_ptr before vDDS 2.0), see the notes there
+/// for the differences.
+struct data_header : plain_header {
+	using shared_t    = vdds::shared_t;    ///< generic shared data type used with std::shared_ptr
+	using intrusive_t = vdds::intrusive_t; ///< intrusively refcounted shared data type
+	using shared_p    = shared_handle;
+
 	shared_p    shared;    ///< Shared data. Used by derived types for shared payload.
+
+	data_header() = default;
+
+	/// Copy that takes over a shared payload reference added with shared_handle::add_ref()
+	data_header(const data_header& d, adopt_ref_t a) : plain_header(d), shared(d.shared, a) {}
+};
+
+/// Base data type for PubSub operations.
+/// User-defined types shall be derived from one of the size classes below.
+/// Topics, subscriber queues and sample pools are sized for the data size class, so that
+/// the queue footprint and the copy cost match the actual message size.
+/// @param N total size of the data in bytes (header and plain payload)
+template<size_t N>
+struct basic_data : data_header {
+	static_assert(N > sizeof(data_header), "data size class is too small");
+
+	using slot_type = basic_data<N>; ///< size class of the derived types
+
+	// Generic plain data type used for small payload
+	using plain_t = std::array<uint8_t, N - sizeof(data_header)>;
+
 	plain_t     plain;     ///< Plain data. Used by derived types for plain payload.
+
+	basic_data() = default;
+
+	/// Copy that takes over a shared payload reference (@see data_header)
+	basic_data(const basic_data& d, adopt_ref_t a) : data_header(d, a), plain(d.plain) {}
+};
+
+/// Data size classes
+using data64  = basic_data<64>;   ///< one cacheline
+using data128 = basic_data<128>;  ///< two cachelines
+using data256 = basic_data<256>;  ///< four cachelines (default)
+using data1k  = basic_data<1024>;
+using data4k  = basic_data<4096>;
+
+/// Plain-only data type.
+/// Same as vdds::basic_data without the shared payload. Trivially copyable, queue slots
+/// are copied with plain loads and stores and are never destroyed.
+/// @param N total size of the data in bytes (header and plain payload)
+template<size_t N>
+struct plain_data : plain_header {
+	static_assert(N > sizeof(plain_header), "data size class is too small");
+
+	using slot_type = plain_data<N>; ///< size class of the derived types
+
+	// Generic plain data type
+	using plain_t = std::array<uint8_t, N - sizeof(plain_header)>;
+
+	plain_t     plain;     ///< Plain data. Used by derived types for payload.
+
+	plain_data() = default;
+
+	/// Same as the copy, there is no shared payload (@see basic_data)
+	plain_data(const plain_data& d, adopt_ref_t) : plain_data(d) {}
 };
 
+/// Plain-only data size classes
+using plain64  = plain_data<64>;
+using plain128 = plain_data<128>;
+using plain256 = plain_data<256>;
+using plain1k  = plain_data<1024>;
+using plain4k  = plain_data<4096>;
+
+static_assert(std::is_trivially_copyable<plain64>::value, "plain data must be trivially copyable");
+
+/// Default data type.
+/// Sized to be exactly 256 bytes (4 cachelines on most CPUs).
+using data = data256;
+
+static_assert(sizeof(data) == 256, "unexpected data size");
+
 } // namespace vdds
 
 #endif // VDDS_DATA_HPP
@@ -0,0 +1,71 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_DETAIL_ALIGNED_HPP
+#define VDDS_DETAIL_ALIGNED_HPP
+
+#include <stdlib.h>
+#include <cstddef>
+#include <new>
+
+namespace vdds {
+namespace detail {
+
+/// Aligned heap allocation.
+/// Plain operator new does not honor extended alignment before C++17, so types that are
+/// padded to the cacheline (alignas) would end up only 16-byte aligned on the heap.
+/// Such types derive from this class to get class-specific operator new/delete
+/// that allocate with the alignment of the type.
+/// @param T derived type
+template <typename T>
+struct aligned_new {
+	static void* operator new(size_t n)
+	{
+		constexpr size_t a = alignof(T) < sizeof(void*) ? sizeof(void*) : alignof(T);
+		void* p;
+		if (posix_memalign(&p, a, n))
+			throw std::bad_alloc();
+		return p;
+	}
+
+	static void* operator new[](size_t n) { return operator new(n); }
+
+	static void operator delete(void* p) noexcept { free(p); }
+	static void operator delete[](void* p) noexcept { free(p); }
+
+	// Placement forms (hidden by the class-specific operators otherwise)
+	static void* operator new(size_t, void* p) noexcept { return p; }
+	static void  operator delete(void*, void*) noexcept { }
+};
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_ALIGNED_HPP
@@ -0,0 +1,117 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_DETAIL_APPEND_LIST_HPP
+#define VDDS_DETAIL_APPEND_LIST_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+namespace vdds {
+namespace detail {
+
+/// Append-only list with lock-free readers.
+/// Entries are stored in chunks that double in size (64, 128, 256, ...), chunks are never
+/// moved or freed while the list is alive, so appends don't copy the existing entries.
+/// The writer fills in the entry and then publishes the new size, readers load the size
+/// and see an immutable prefix of the list.
+/// Appends must be serialized by the caller.
+/// @param T entry type (trivially copyable)
+template<typename T>
+class append_list {
+private:
+	static constexpr unsigned int base_shift = 6;  // first chunk has 64 entries
+	static constexpr unsigned int max_chunks = 32;
+
+	std::atomic<T*>     _chunks[max_chunks]; ///> chunk pointers (allocated as the list grows)
+	std::atomic<size_t> _size;               ///> number of published entries
+
+	/// Get chunk index and offset in the chunk for the entry index
+	static void locate(size_t i, unsigned int& c, size_t& off)
+	{
+		// Chunk c holds (2^c - 1) * 64 .. (2^(c+1) - 1) * 64 - 1
+		size_t j = (i >> base_shift) + 1;
+		c   = 63 - __builtin_clzll(j);
+		off = i - (((size_t(1) << c) - 1) << base_shift);
+	}
+
+public:
+	append_list() : _size(0)
+	{
+		for (auto &c : _chunks) c.store(nullptr, std::memory_order_relaxed);
+	}
+
+	~append_list()
+	{
+		for (auto &c : _chunks) delete [] c.load(std::memory_order_relaxed);
+	}
+
+	// No copies
+	append_list(const append_list&) = delete;
+	append_list& operator=(const append_list&) = delete;
+
+	/// Get number of entries.
+	/// Entries below the returned size are safe to read.
+	size_t size() const { return _size.load(std::memory_order_acquire); }
+
+	/// Get entry
+	/// @param i index (must be below size())
+	const T& operator[](size_t i) const
+	{
+		unsigned int c; size_t off;
+		locate(i, c, off);
+		return _chunks[c].load(std::memory_order_relaxed)[off];
+	}
+
+	/// Append entry (writer only)
+	void push_back(const T& v)
+	{
+		size_t n = _size.load(std::memory_order_relaxed);
+
+		unsigned int c; size_t off;
+		locate(n, c, off);
+
+		T* p = _chunks[c].load(std::memory_order_relaxed);
+		if (!p) {
+			p = new T[size_t(1) << (c + base_shift)];
+			_chunks[c].store(p, std::memory_order_relaxed);
+		}
+		p[off] = v;
+
+		// Publish the entry (and the new chunk)
+		_size.store(n + 1, std::memory_order_release);
+	}
+};
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_APPEND_LIST_HPP
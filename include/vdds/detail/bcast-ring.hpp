@@ -0,0 +1,233 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_DETAIL_BCAST_RING_HPP
+#define VDDS_DETAIL_BCAST_RING_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+#include "../data.hpp"
+#include "aligned.hpp"
+
+namespace vdds {
+namespace detail {
+
+/// Seqlock copy.
+/// Copies the data with relaxed atomic word loads and stores. Readers race with the writers
+/// by design and validate the copy with the slot stamp, atomic accesses keep the race well
+/// defined (and visible to the thread sanitizer).
+/// @param dst destination (8 byte aligned)
+/// @param src source (8 byte aligned)
+/// @param n number of bytes
+inline void seqlock_copy(void* dst, const void* src, size_t n)
+{
+	typedef uint64_t __attribute__((may_alias)) word;
+	typedef uint8_t  __attribute__((may_alias)) byte;
+
+	size_t i = 0;
+	for (; i + sizeof(word) <= n; i += sizeof(word)) {
+		auto w = __atomic_load_n(reinterpret_cast<const word*>(static_cast<const byte*>(src) + i), __ATOMIC_RELAXED);
+		__atomic_store_n(reinterpret_cast<word*>(static_cast<byte*>(dst) + i), w, __ATOMIC_RELAXED);
+	}
+	for (; i < n; i++) {
+		auto b = __atomic_load_n(static_cast<const byte*>(src) + i, __ATOMIC_RELAXED);
+		__atomic_store_n(static_cast<byte*>(dst) + i, b, __ATOMIC_RELAXED);
+	}
+}
+
+/// Ring slot data.
+/// Slot can be overwritten while it's being read, the copy is validated by the ring.
+/// @param T data size class
+template<typename T>
+struct ring_cell;
+
+/// Ring slot with plain-only data
+template<size_t N>
+struct ring_cell<plain_data<N>> {
+	plain_data<N> v; ///> data
+
+	void load(plain_data<N>& dst) const { seqlock_copy(&dst, &v, sizeof(v)); }
+
+	template<typename... A>
+	void store(const plain_data<N>& src, A...) { seqlock_copy(&v, &src, sizeof(v)); }
+};
+
+/// Ring slot with shared payload.
+/// Shared payload is copied under the handle lock (@see shared_handle::atomic_load),
+/// the flag lets the readers skip the lock for the entries without shared payload.
+template<size_t N>
+struct ring_cell<basic_data<N>> {
+	using shared_p = data_header::shared_p;
+
+	basic_data<N>     v;      ///> data
+	std::atomic<bool> shared; ///> v.shared is not empty
+
+	ring_cell() : shared(false) {}
+
+	void load(basic_data<N>& dst) const
+	{
+		seqlock_copy(static_cast<plain_header*>(&dst), static_cast<const plain_header*>(&v), sizeof(plain_header));
+		seqlock_copy(dst.plain.data(), v.plain.data(), sizeof(v.plain));
+		if (shared.load(std::memory_order_relaxed))
+			dst.shared = shared_p::atomic_load(&v.shared);
+		else
+			dst.shared.reset();
+	}
+
+	/// @param a copy args (adopt_ref - takes over the shared payload reference)
+	template<typename... A>
+	void store(const basic_data<N>& src, A... a)
+	{
+		seqlock_copy(static_cast<plain_header*>(&v), static_cast<const plain_header*>(&src), sizeof(plain_header));
+		seqlock_copy(v.plain.data(), src.plain.data(), sizeof(v.plain));
+		shared.store((bool) src.shared, std::memory_order_relaxed);
+		shared_p::atomic_store(&v.shared, shared_p(src.shared, a...));
+	}
+};
+
+/// Broadcast ring.
+/// Sequenced ring buffer with a single copy of the data shared by all readers.
+/// Writers store data at the positions they claimed (unique, monotonic).
+/// Readers keep their own positions (cursors) and never write into the ring.
+/// Slow readers are overrun by the writers, the overrun is detected and reported
+/// as reader lag.
+/// Each slot is protected by a seqlock-style stamp (position + 1, or busy).
+/// @param T data size class (vdds::basic_data or vdds::plain_data)
+template <typename T>
+class bcast_ring {
+private:
+	static constexpr uint64_t busy = UINT64_MAX;
+
+	struct alignas(64) slot : aligned_new<slot> {
+		std::atomic<uint64_t> stamp; ///> position + 1 of the stored data (0 - empty, busy - write in progress)
+		ring_cell<T> c;              ///> data
+	};
+
+	size_t _depth;                   ///> number of slots
+	std::unique_ptr<slot[]> _slots;  ///> slot storage
+
+public:
+	/// Create ring
+	/// @param depth number of slots
+	explicit bcast_ring(size_t depth) : _depth(depth), _slots(new slot[depth])
+	{
+		if (!_depth)
+			throw std::invalid_argument("invalid ring depth");
+		for (size_t i = 0; i < _depth; i++)
+			_slots[i].stamp.store(0, std::memory_order_relaxed);
+	}
+
+	// No copies
+	bcast_ring(const bcast_ring&) = delete;
+	bcast_ring& operator=(const bcast_ring&) = delete;
+
+	/// Get ring depth
+	size_t depth() const { return _depth; }
+
+	/// Store data.
+	/// Lockfree. Concurrent writers wait only if they target the same slot.
+	/// @param pos position claimed by the writer
+	/// @param v data
+	/// @param a copy args (adopt_ref - the shared payload reference is taken over only if stored)
+	/// @return false if the slot already holds newer data (the writer was overrun)
+	template<typename... A>
+	bool store(uint64_t pos, const T& v, A... a)
+	{
+		slot& s = _slots[pos % _depth];
+
+		uint64_t st = s.stamp.load(std::memory_order_relaxed);
+		for (;;) {
+			if (st == busy) { st = s.stamp.load(std::memory_order_relaxed); continue; }
+			if (st > pos)   { return false; }
+			if (s.stamp.compare_exchange_weak(st, busy, std::memory_order_acquire, std::memory_order_relaxed))
+				break;
+		}
+		std::atomic_thread_fence(std::memory_order_release);
+
+		s.c.store(v, a...);
+
+		s.stamp.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Load data.
+	/// Lockfree and nonblocking for the plain data. Entries with shared payload take
+	/// a short striped lock to copy the payload reference (@see shared_handle::atomic_load).
+	/// @param[in,out] pos reader position, advanced past the loaded data and overrun data
+	/// @param[out] v data
+	/// @param[in,out] lag number of overrun (lost) data entries is added to this counter
+	/// @param[in] head ring head (next position to be claimed by the writers)
+	/// @return false if no data is available at the reader position
+	bool load(uint64_t& pos, T& v, size_t& lag, const std::atomic<uint64_t>& head)
+	{
+		for (;;) {
+			slot& s = _slots[pos % _depth];
+
+			uint64_t st = s.stamp.load(std::memory_order_acquire);
+			if (st == busy) {
+				// Slot is being overwritten if the writers are a full lap ahead
+				uint64_t np = head.load(std::memory_order_acquire);
+				if (np - pos <= _depth) return false; // not written yet
+
+				// Overrun. Skip to the oldest position that may still be available.
+				np -= _depth;
+				lag += np - pos;
+				pos  = np;
+				continue;
+			}
+			if (st <= pos) return false; // not written yet
+
+			if (st - 1 > pos) {
+				// Overrun. Skip to the oldest position that may still be available.
+				uint64_t np = st - _depth;
+				lag += np - pos;
+				pos  = np;
+				continue;
+			}
+
+			s.c.load(v);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (s.stamp.load(std::memory_order_relaxed) != st)
+				continue; // overwritten while reading
+
+			pos++;
+			return true;
+		}
+	}
+};
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_BCAST_RING_HPP
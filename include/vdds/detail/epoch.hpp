@@ -0,0 +1,133 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_DETAIL_EPOCH_HPP
+#define VDDS_DETAIL_EPOCH_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+
+#include "aligned.hpp"
+
+namespace vdds {
+namespace detail {
+
+/// Epoch based reclamation.
+/// Readers announce the global epoch in a per-thread record while they hold references to
+/// shared objects. Writers unlink the objects and retire them, retired objects are freed
+/// once all readers that could have seen them have left their critical sections.
+/// The read side does not write any shared state.
+class epoch {
+public:
+	/// Per-thread record
+	struct alignas(64) record : aligned_new<record> {
+		std::atomic<uint64_t> local;  ///> announced epoch (0 - quiescent)
+		std::atomic<bool>     in_use; ///> record is owned by a thread
+		unsigned int          depth;  ///> critical section nesting depth
+		record*               next;   ///> next record in the global list
+	};
+
+private:
+	static std::atomic<uint64_t> _global; ///> global epoch
+
+	/// Get a record for the calling thread (allocates or reuses a free one)
+	static record* attach();
+
+	/// Get the calling thread's record
+	static record* local()
+	{
+		static thread_local record* r = nullptr;
+		if (!r) r = attach();
+		return r;
+	}
+
+public:
+	/// Enter read-side critical section.
+	/// Critical sections can be nested.
+	static void enter()
+	{
+		record* r = local();
+		if (r->depth++) return;
+
+		r->local.store(_global.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+		// Announcement must be visible before the shared pointers are loaded (@see retire())
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	/// Exit read-side critical section
+	static void exit()
+	{
+		record* r = local();
+		if (--r->depth) return;
+		r->local.store(0, std::memory_order_release);
+	}
+
+	/// Retire object.
+	/// The object must be unlinked (not reachable by new readers) before this call.
+	/// It's freed lazily once all readers that could hold a reference are done.
+	/// @param p object pointer
+	/// @param del deleter
+	static void retire(void* p, void (*del)(void*));
+
+	/// Retire object allocated with new.
+	template<typename T>
+	static void retire(T* p)
+	{
+		retire(static_cast<void*>(p), [](void* v) { delete static_cast<T*>(v); });
+	}
+
+	/// Wait for grace period.
+	/// Returns once all readers that were in the critical section at the time of the call
+	/// are done. Blocks (yields) the calling thread, must be called outside of the critical section.
+	static void synchronize();
+
+	/// Free retired objects that are no longer referenced
+	static void collect();
+
+	/// Get number of retired objects waiting to be freed
+	static size_t pending();
+
+	/// Scoped read-side critical section
+	class guard {
+	public:
+		guard()  { enter(); }
+		~guard() { exit(); }
+
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+	};
+};
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_EPOCH_HPP
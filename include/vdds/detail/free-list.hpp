@@ -0,0 +1,98 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_DETAIL_FREE_LIST_HPP
+#define VDDS_DETAIL_FREE_LIST_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+namespace vdds {
+namespace detail {
+
+/// Lock-free list of free indices.
+/// Simple Treiber stack of 32-bit indices. The head is tagged with a generation
+/// counter to avoid ABA. LIFO order keeps recently released (cache-hot) entries in use.
+class free_list {
+private:
+	static constexpr uint32_t none = UINT32_MAX;
+
+	std::unique_ptr<std::atomic<uint32_t>[]> _next; ///> next index for each entry
+	std::atomic<uint64_t> _head;                    ///> tag:32 | index:32
+	size_t _size;                                   ///> max number of entries
+
+	static uint64_t make_head(uint64_t h, uint32_t i) { return ((h >> 32) + 1) << 32 | i; }
+	static uint32_t head_index(uint64_t h) { return static_cast<uint32_t>(h); }
+
+public:
+	/// Create free list.
+	/// @param n max number of entries (list is initially empty)
+	explicit free_list(size_t n) :
+		_next(new std::atomic<uint32_t>[n]), _head(none), _size(n)
+	{ }
+
+	// No copies
+	free_list(const free_list&) = delete;
+	free_list& operator=(const free_list&) = delete;
+
+	/// Get max number of entries
+	size_t size() const { return _size; }
+
+	/// Push index
+	/// @param i index
+	void push(uint32_t i) noexcept
+	{
+		uint64_t h = _head.load(std::memory_order_relaxed);
+		do {
+			_next[i].store(head_index(h), std::memory_order_relaxed);
+		} while (!_head.compare_exchange_weak(h, make_head(h, i),
+				std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	/// Pop index
+	/// @param[out] i index
+	/// @return false if the list is empty
+	bool pop(uint32_t& i) noexcept
+	{
+		uint64_t h = _head.load(std::memory_order_acquire);
+		do {
+			if (head_index(h) == none) return false;
+			i = head_index(h);
+		} while (!_head.compare_exchange_weak(h, make_head(h, _next[i].load(std::memory_order_relaxed)),
+				std::memory_order_acquire, std::memory_order_acquire));
+		return true;
+	}
+};
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_FREE_LIST_HPP
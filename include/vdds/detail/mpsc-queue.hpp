@@ -0,0 +1,234 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+// Bounded multi-producer queue based on the well known array-based design by Dmitry Vyukov
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// Simplified for the single-consumer case.
+
+#ifndef VDDS_DETAIL_MPSC_QUEUE_HPP
+#define VDDS_DETAIL_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "aligned.hpp"
+
+namespace vdds {
+namespace detail {
+
+/// Bounded lock-free multi-producer single-consumer queue.
+/// Producers claim positions with a CAS on the tail, each slot carries a sequence
+/// number that tells the consumer when the slot is ready and the producers when
+/// it's free.
+template <typename T>
+class mpsc_queue : public aligned_new<mpsc_queue<T>> {
+private:
+	static constexpr size_t kCacheLineSize = 64;
+
+	struct slot {
+		std::atomic<size_t> seq;                                           ///> slot sequence
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; ///> value storage
+
+		T* value() { return reinterpret_cast<T*>(&storage); }
+	};
+
+	size_t _capacity;                ///> number of slots
+	std::unique_ptr<slot[]> _slots;  ///> slot storage
+
+	alignas(kCacheLineSize) std::atomic<size_t> _tail = {0}; ///> next position to be written (producers)
+	alignas(kCacheLineSize) std::atomic<size_t> _head = {0}; ///> next position to be read (consumer)
+
+public:
+	/// Create queue
+	/// @param capacity queue capacity
+	explicit mpsc_queue(size_t capacity) : _capacity(capacity ? capacity : 1), _slots(new slot[_capacity])
+	{
+		for (size_t i = 0; i < _capacity; i++)
+			_slots[i].seq.store(i, std::memory_order_relaxed);
+	}
+
+	~mpsc_queue()
+	{
+		while (front()) { pop(); }
+	}
+
+	// non-copyable and non-movable
+	mpsc_queue(const mpsc_queue &) = delete;
+	mpsc_queue &operator=(const mpsc_queue &) = delete;
+
+	/// Push.
+	/// Lockfree and nonblocking. Safe to call from multiple threads.
+	/// @return false if the queue is full
+	bool push(const T& v) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	{
+		return emplace(v);
+	}
+
+	/// Construct element in place.
+	/// Same as push(), the element is constructed only if there is room.
+	/// @return false if the queue is full
+	template <typename... Args>
+	bool emplace(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value)
+	{
+		size_t pos = _tail.load(std::memory_order_relaxed);
+		for (;;) {
+			slot& s = _slots[pos % _capacity];
+			size_t seq = s.seq.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+			if (diff == 0) {
+				if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return false; // full
+			} else {
+				pos = _tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot& s = _slots[pos % _capacity];
+		new (s.value()) T(std::forward<Args>(args)...);
+		s.seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// Push up to n elements.
+	/// Claims the whole range with a single CAS on the tail.
+	/// Lockfree and nonblocking. Safe to call from multiple threads.
+	/// @return number of elements pushed (less than n if the queue is full)
+	size_t push(const T* v, size_t n) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	{
+		size_t pos = _tail.load(std::memory_order_relaxed);
+		size_t k;
+		for (;;) {
+			// Consumer frees the slots in order and updates the head after the slot
+			// sequence, everything below head + capacity is free.
+			size_t head = _head.load(std::memory_order_acquire);
+			std::ptrdiff_t used = static_cast<std::ptrdiff_t>(pos - head);
+			if (used < 0) {
+				pos = _tail.load(std::memory_order_relaxed);
+				continue;
+			}
+
+			// Head lags behind the released slots while the consumer is draining
+			if (static_cast<size_t>(used) >= _capacity) return 0; // full
+
+			k = std::min(n, _capacity - static_cast<size_t>(used));
+
+			if (_tail.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+				break;
+		}
+
+		for (size_t i = 0; i < k; i++) {
+			slot& s = _slots[(pos + i) % _capacity];
+			new (s.value()) T(v[i]);
+			s.seq.store(pos + i + 1, std::memory_order_release);
+		}
+		return k;
+	}
+
+	/// Get pointer to the front element.
+	/// Must be called only from the consumer thread.
+	/// @return nullptr if the queue is empty
+	T* front() noexcept
+	{
+		size_t pos = _head.load(std::memory_order_relaxed);
+		slot& s = _slots[pos % _capacity];
+		if (s.seq.load(std::memory_order_acquire) != pos + 1) return nullptr;
+		return s.value();
+	}
+
+	/// Pop front element.
+	/// Must be called only after front() has returned non-nullptr.
+	void pop() noexcept
+	{
+		size_t pos = _head.load(std::memory_order_relaxed);
+		slot& s = _slots[pos % _capacity];
+		s.value()->~T();
+		s.seq.store(pos + _capacity, std::memory_order_release);
+		_head.store(pos + 1, std::memory_order_release);
+	}
+
+	/// Pop front element.
+	/// @param[out] v popped value
+	/// @return false if the queue is empty
+	bool pop(T& v) noexcept
+	{
+		T* n = front();
+		if (!n) return false;
+		v = *n;
+		pop();
+		return true;
+	}
+
+	/// Consume up to max elements in place.
+	/// Slots are released one by one, the head is updated once.
+	/// Must be called only from the consumer thread. The callback must not throw.
+	/// @return number of consumed elements
+	template <typename F>
+	size_t consume(F&& fn, size_t max) noexcept
+	{
+		size_t pos = _head.load(std::memory_order_relaxed);
+		size_t n = 0;
+		for (; n < max; n++, pos++) {
+			slot& s = _slots[pos % _capacity];
+			if (s.seq.load(std::memory_order_acquire) != pos + 1) break;
+			fn(*s.value());
+			s.value()->~T();
+			s.seq.store(pos + _capacity, std::memory_order_release);
+		}
+
+		if (n) _head.store(pos, std::memory_order_release);
+		return n;
+	}
+
+	/// Get number of queued elements (approximate while producers are active)
+	size_t size() const noexcept
+	{
+		size_t t = _tail.load(std::memory_order_acquire);
+		size_t h = _head.load(std::memory_order_acquire);
+		return t > h ? t - h : 0;
+	}
+
+	/// Get number of successful push ops
+	size_t push_count() const noexcept { return _tail.load(std::memory_order_relaxed); }
+
+	size_t capacity() const noexcept { return _capacity; }
+};
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_MPSC_QUEUE_HPP
@@ -0,0 +1,131 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_DETAIL_PLACEMENT_HPP
+#define VDDS_DETAIL_PLACEMENT_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <new>
+
+namespace vdds {
+namespace detail {
+
+/// Memory placement.
+/// Default placement uses the regular heap.
+struct placement {
+	int  node = -1;         ///< NUMA node (-1 - no preference)
+	bool hugepages = false; ///< back the memory with 2MB hugepages
+	bool deferred = false;  ///< node is picked later by the consumer thread (@see bind)
+
+	/// Check if the memory has to be mapped directly (non-default placement)
+	bool mapped() const { return node >= 0 || hugepages || deferred; }
+};
+
+/// Get the NUMA node of the calling thread
+int current_node();
+
+/// Map anonymous memory according to the placement.
+/// The size is rounded up to the page size (or the hugepage size).
+/// Explicit hugepages are used if available, with fallback to transparent hugepages.
+/// Node binding is a preference, the kernel falls back to other nodes under memory pressure.
+/// @param[in] size size of the memory
+/// @param[in] p placement
+/// @param[out] huge set to true if the memory is backed by explicit hugepages (optional)
+/// @return pointer to the memory, nullptr on failure
+void* map(size_t size, const placement& p, bool* huge = nullptr);
+
+/// Bind mapped memory to the NUMA node.
+/// Used for the deferred placement. Pages that are already populated are migrated
+/// to the node, the rest is allocated there on the first touch.
+/// @param[in] addr memory pointer (as returned by map())
+/// @param[in] size size of the memory (as passed to map())
+/// @param[in] p placement (as passed to map())
+/// @param[in] node NUMA node
+void bind(void* addr, size_t size, const placement& p, int node);
+
+/// Unmap memory allocated with map()
+/// @param[in] addr memory pointer
+/// @param[in] size size of the memory (as passed to map())
+/// @param[in] p placement (as passed to map())
+void unmap(void* addr, size_t size, const placement& p);
+
+/// Allocator for the queue slots.
+/// Uses std::allocator for the default placement and map() otherwise.
+/// @param T value type
+template<typename T>
+struct slot_allocator {
+	using value_type = T;
+
+	placement where;           ///< memory placement
+	void*     region = nullptr; ///< mapped memory (last allocation, used for the deferred binding)
+	size_t    region_size = 0;  ///< size of the mapped memory
+
+	slot_allocator() = default;
+	explicit slot_allocator(const placement& p) : where(p) {}
+	template<typename U> slot_allocator(const slot_allocator<U>& a) : where(a.where) {}
+
+	T* allocate(size_t n)
+	{
+		if (!where.mapped()) return std::allocator<T>().allocate(n);
+		void* p = map(n * sizeof(T), where);
+		if (!p) throw std::bad_alloc();
+		region = p;
+		region_size = n * sizeof(T);
+		return static_cast<T*>(p);
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		if (!where.mapped())
+			std::allocator<T>().deallocate(p, n);
+		else
+			unmap(p, n * sizeof(T), where);
+	}
+};
+
+template<typename T, typename U>
+bool operator==(const slot_allocator<T>& a, const slot_allocator<U>& b)
+{
+	return a.where.node == b.where.node && a.where.hugepages == b.where.hugepages &&
+		a.where.deferred == b.where.deferred;
+}
+
+template<typename T, typename U>
+bool operator!=(const slot_allocator<T>& a, const slot_allocator<U>& b)
+{
+	return !(a == b);
+}
+
+} // namespace detail
+} // namespace vdds
+
+#endif // VDDS_DETAIL_PLACEMENT_HPP
@@ -59,11 +59,14 @@
 #include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <stdexcept>
 #include <memory>      // std::allocator
-#include <new>         // std::hardware_destructive_interference_size
+#include <new>         // placement new
 #include <type_traits> // std::enable_if, std::is_*_constructible
 
+#include "aligned.hpp"
+
 #if defined(__has_cpp_attribute) && __has_cpp_attribute(nodiscard)
 #define __spsc_nodiscard [[nodiscard]]
 #else
@@ -72,7 +75,8 @@
 
 namespace vdds {
 
-template <typename T, typename Allocator = std::allocator<T>> class spsc_queue {
+template <typename T, typename Allocator = std::allocator<T>>
+class spsc_queue : public detail::aligned_new<spsc_queue<T, Allocator>> {
 public:
 	explicit spsc_queue(const size_t capacity, const Allocator &allocator = Allocator())
 			: _capacity(capacity), _allocator(allocator)
@@ -136,6 +140,34 @@ public:
 		return emplace(std::forward<P>(v));
 	}
 
+	/// Push up to n elements with a single write index update.
+	/// @return number of elements pushed (less than n if the queue is full)
+	__spsc_nodiscard size_t push(const T *v, size_t n) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	{
+		static_assert(std::is_copy_constructible<T>::value, "T must be copy constructible");
+
+		auto const w_idx = _write_idx.load(std::memory_order_relaxed);
+
+		auto room = [&]() {
+			std::ptrdiff_t diff = _read_idx_cache - w_idx - 1;
+			if (diff < 0) { diff += _capacity; }
+			return static_cast<size_t>(diff);
+		};
+
+		size_t avail = room();
+		if (avail < n) {
+			_read_idx_cache = _read_idx.load(std::memory_order_acquire);
+			avail = room();
+		}
+		if (n > avail) { n = avail; }
+		if (!n) { return 0; } // full
+
+		// inplace construct/init and update write_idx once
+		auto idx = copy_in(w_idx, v, n, std::is_trivially_copyable<T>());
+		_write_idx.store(idx, std::memory_order_release);
+		return n;
+	}
+
 	__spsc_nodiscard T *front() noexcept
 	{
 		auto const r_idx = _read_idx.load(std::memory_order_relaxed);
@@ -161,6 +193,31 @@ public:
 		_read_idx.store(next_r_idx, std::memory_order_release);
 	}
 
+	/// Consume up to max elements in place with a single read index update.
+	/// The callback gets a reference to each slot before it's released, and must not throw.
+	/// @return number of consumed elements
+	template <typename F>
+	size_t consume(F &&fn, size_t max) noexcept
+	{
+		static_assert(std::is_nothrow_destructible<T>::value, "T must be nothrow destructible");
+
+		auto r_idx = _read_idx.load(std::memory_order_relaxed);
+		if (r_idx == _write_idx_cache) {
+			_write_idx_cache = _write_idx.load(std::memory_order_acquire);
+		}
+
+		size_t n = 0;
+		for (; n < max && r_idx != _write_idx_cache; n++) {
+			T &v = _slots[r_idx + kPadding];
+			fn(v);
+			v.~T();
+			if (++r_idx == _capacity) { r_idx = 0; }
+		}
+
+		if (n) { _read_idx.store(r_idx, std::memory_order_release); }
+		return n;
+	}
+
 	__spsc_nodiscard bool pop(T &v) noexcept
 	{
 		T *n = front();
@@ -184,6 +241,8 @@ public:
 
 	size_t capacity() const noexcept { return _capacity - 1; }
 
+	const Allocator& get_allocator() const noexcept { return _allocator; }
+
 	__spsc_nodiscard size_t write_available() const noexcept
 	{
 		std::ptrdiff_t diff = _read_idx.load(std::memory_order_acquire) - _write_idx.load(std::memory_order_acquire);
@@ -192,15 +251,36 @@ public:
 	}
 
 private:
-#ifdef __cpp_lib_hardware_interference_size
-	static constexpr size_t kCacheLineSize = std::hardware_destructive_interference_size;
-#else
-       	static constexpr size_t kCacheLineSize = 64;
-#endif
+	// Fixed, hardware_destructive_interference_size is not ABI-stable (GCC warns about it)
+	// and would change the queue layout between C++14 and C++20 (coroutines) builds.
+	static constexpr size_t kCacheLineSize = 64;
 
 	// Padding to avoid false sharing between _slots and adjacent allocations
 	static constexpr size_t kPadding = (kCacheLineSize - 1) / sizeof(T) + 1;
 
+private:
+	// Construct n elements starting at slot idx, returns the next slot index
+	size_t copy_in(size_t idx, const T *v, size_t n, std::false_type) noexcept(std::is_nothrow_copy_constructible<T>::value)
+	{
+		for (size_t i = 0; i < n; i++) {
+			new (&_slots[idx + kPadding]) T(v[i]);
+			if (++idx == _capacity) { idx = 0; }
+		}
+		return idx;
+	}
+
+	// Trivially copyable elements are copied in at most two contiguous runs
+	size_t copy_in(size_t idx, const T *v, size_t n, std::true_type) noexcept
+	{
+		size_t k = _capacity - idx;
+		if (k > n) { k = n; }
+		std::memcpy(static_cast<void *>(&_slots[idx + kPadding]), v, k * sizeof(T));
+		std::memcpy(static_cast<void *>(&_slots[kPadding]), v + k, (n - k) * sizeof(T));
+		idx += n;
+		if (idx >= _capacity) { idx -= _capacity; }
+		return idx;
+	}
+
 private:
 	size_t _capacity;
 	T     *_slots;
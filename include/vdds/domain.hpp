@@ -34,36 +34,77 @@
 #include <string>
 #include <vector>
 #include <chrono>
-#include <shared_mutex>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 #include <hogl/area.hpp>
 
+#include "detail/append-list.hpp"
 #include "topic.hpp"
 #include "query.hpp"
+#include "qos.hpp"
 
 namespace vdds {
 
+class buffer_pool;
+
 /// Top-level VDDS domain.
 /// Container for topics and PubSub data structures.
 class domain {
 private:
-	using unique_topic = std::unique_ptr<topic>;
-	using topic_vect   = std::vector<unique_topic>;
+	/// Topic name key.
+	/// References the name owned by the topic itself (interned for the lifetime
+	/// of the domain), the index does not keep its own copies of the names.
+	using name_ref = std::reference_wrapper<const std::string>;
+
+	struct name_hash {
+		size_t operator()(const name_ref& n) const { return std::hash<std::string>()(n.get()); }
+	};
+	struct name_equal {
+		bool operator()(const name_ref& a, const name_ref& b) const { return a.get() == b.get(); }
+	};
+
+	using topic_index  = std::unordered_map<name_ref, topic_base*, name_hash, name_equal>;
 
 	std::string _name;  ///< Domain name.
 	hogl::area* _area;  ///< Log area.
 
-	// We could use a map or hashmap here but so far there is no
-	// requirement to support large number of topics.
+	topic_index _index;  ///< Topic name index for O(1) lookups (hashmap, protected by mutex)
+	std::mutex  _mutex;  ///< Mutex used for serializing topic creation (writers only)
+
+	/// Topics owned by the domain, in creation order.
+	/// Append-only (topics are never deleted), readers (query, dump, kick, shutdown) see
+	/// the topics created so far without the mutex and without copying the list on updates.
+	detail::append_list<topic_base*> _topics;
+
+	std::vector<buffer_pool*> _pools; ///< Buffer pool list (vector, protected by pool mutex)
+	std::mutex  _pool_mutex; ///< Mutex used for syncing pool list access & updates (never held by topic creation)
+
+	/// Register and unregister buffer pool (@see vdds::buffer_pool)
+	void add_pool(buffer_pool* p);
+	void remove_pool(buffer_pool* p);
 
-	topic_vect _topics; ///< Topic list (vector, protected by mutex)
-	std::shared_timed_mutex _mutex; ///< Mutex used for syncing topic list access & updates
+	friend class buffer_pool;
+
+	/// Find or add topic.
+	/// @param[in] name topic name
+	/// @param[in] data_type data type name
+	/// @param[in] qos topic QoS
+	/// @param[in] slot_size data size class
+	/// @param[in] plain plain-only data
+	/// @param[in] make topic factory (called under the lock if the topic does not exist)
+	/// @return topic pointer or null if the topic exists with different data type or size class
+	topic_base* add_topic(const std::string& name, const std::string& data_type, const topic_qos& qos,
+			size_t slot_size, bool plain, const std::function<topic_base*()>& make);
 
 public:
 	/// Create domain
 	/// @param[in] domain name (should be all caps as a convention)
 	explicit domain(const std::string& name = "");
 
+	~domain();
+
 	// No copies
 	domain( const domain& ) = delete;
 	domain& operator=( const domain& ) = delete;
@@ -77,10 +118,21 @@ public:
 	/// If the topic with the same name already exists, and data-types match
 	/// it is returned and used for all PubSub operations.
 	/// Topics are never deleted (lifetime of the domain).
+	/// Topic QoS is set by the first call, QoS passed to subsequent calls is ignored.
+	/// @param D data size class (must match for all users of the topic)
 	/// @param[in] name topic name
 	/// @param[in] data_type data type name
-	/// @return name as const ref to string
-	topic* create_topic(const std::string& name, const std::string& data_type);
+	/// @param[in] qos topic QoS
+	/// @return topic pointer or null on errors
+	template<typename D = data>
+	basic_topic<D>* create_topic(const std::string& name, const std::string& data_type,
+			const topic_qos& qos = topic_qos())
+	{
+		auto t = add_topic(name, data_type, qos, sizeof(D), std::is_trivially_copyable<D>::value, [&]() -> topic_base* {
+				return new basic_topic<D>(_name, name, data_type, qos);
+			});
+		return static_cast<basic_topic<D>*>(t);
+	}
 
 	/// Dump domain info & stats into debug log.
 	void dump(const query::filter& flt = query::filter{"any","any"});
@@ -0,0 +1,253 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_EXECUTOR_HPP
+#define VDDS_EXECUTOR_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <functional>
+
+#include "detail/aligned.hpp"
+#include "notifier.hpp"
+#include "domain.hpp"
+#include "sub.hpp"
+
+namespace vdds {
+
+/// Callback executor.
+/// Runs subscription callbacks on a pool of worker threads, instead of a thread per subscriber.
+/// Subscriptions are created through the executor (@see subscribe()) and get a private
+/// notifier that schedules the subscription when data is pushed. Ready subscriptions are
+/// queued on the worker that ran them last (cache locality), idle workers steal from the
+/// busy ones. Callbacks of the same subscription never run concurrently. Higher priority
+/// subscriptions are always dispatched first. Subscriptions are removed when their handles
+/// are destroyed (@see subscription).
+class executor {
+public:
+	/// Priority classes
+	enum class priority {
+		high,   ///< control loops, etc
+		normal, ///< default
+		low     ///< background processing
+	};
+
+	static constexpr unsigned int max_workers = 64;
+
+private:
+	static constexpr unsigned int nprio = 3;
+
+	/// Subscription task.
+	/// Notifier of the subscriber queue, tracks the scheduling state.
+	class task : public notifier {
+	public:
+		enum : uint32_t {
+			idle,    ///< no data
+			queued,  ///< waiting for a worker
+			running, ///< callback is running
+			rerun    ///< callback is running, more data was pushed
+		};
+
+		executor&                 ex;    ///< owner executor
+		unsigned int              prio;  ///< priority class
+		std::atomic<uint32_t>     state; ///< scheduling state (queued until the callback is set)
+		std::atomic<unsigned int> home;  ///< worker that ran the task last
+		std::atomic<bool>         dead;  ///< task is being removed, the callback is not run anymore
+		std::function<size_t(size_t)> run; ///< drain callback, returns number of processed entries
+		std::function<void()>     detach; ///< detaches this notifier from the subscriber queue
+		std::shared_ptr<void>     owner; ///< subscriber (destroyed first, unsubscribes from the topic)
+
+		task(executor& e, unsigned int p, unsigned int h) :
+			notifier("executor"), ex(e), prio(p), state(queued), home(h), dead(false) {}
+
+		/// Schedule the task.
+		/// Called from queue::push.
+		void notify() override;
+
+		/// Not used, the executor waits for the data
+		void wait_for(std::chrono::nanoseconds t) override { std::this_thread::sleep_for(t); }
+	};
+
+	/// Worker thread
+	struct alignas(64) worker : detail::aligned_new<worker> {
+		std::mutex            lock;        ///< protects the run queues
+		std::deque<task*>     runq[nprio]; ///< run queues by priority
+		notifier_futex        nf;          ///< wakes up the worker
+		std::thread           thread;      ///< worker thread
+		std::atomic<uint64_t> run_count;   ///< number of task runs
+		std::atomic<uint64_t> steal_count; ///< number of tasks stolen from other workers
+
+		worker() : run_count(0), steal_count(0) {}
+	};
+
+	std::vector<std::unique_ptr<worker>> _workers; ///> worker threads
+	std::vector<std::unique_ptr<task>>   _tasks;   ///> subscription tasks
+	std::mutex            _tasks_mutex; ///> protects the task list
+	std::atomic<uint64_t> _idle;        ///> bitmask of idle workers
+	std::atomic<bool>     _stop;        ///> workers are stopping
+	std::atomic<unsigned int> _next;    ///> next home worker for new subscriptions
+	size_t                _batch;       ///> max number of entries processed per task run
+
+	/// Queue the task on a worker and wake up a worker
+	void schedule(task* t);
+
+	/// Get next task for the worker (own queues first, then steal)
+	task* next(unsigned int w);
+
+	/// Run the task and reschedule if needed
+	void run(task* t, unsigned int w);
+
+	/// Worker thread loop
+	void loop(unsigned int w);
+
+	/// Create the task (not registered yet)
+	std::unique_ptr<task> make_task(priority p);
+
+	/// Register the task
+	task* add(std::unique_ptr<task> t);
+
+	/// Remove the task.
+	/// Stops the notifications, waits for the queued and running callbacks,
+	/// then unsubscribes and deletes the task.
+	void remove(task* t);
+
+public:
+	/// Create executor and start the workers.
+	/// @param nthreads number of worker threads (max 64), 0 - one per CPU (up to 64)
+	/// @param batch max number of entries processed per subscription run (fairness)
+	explicit executor(unsigned int nthreads = 0, size_t batch = 64);
+
+	/// Stop the workers and remove the remaining subscriptions
+	~executor();
+
+	// No copies
+	executor(const executor&) = delete;
+	executor& operator=(const executor&) = delete;
+
+	/// Subscription handle.
+	/// Owns the subscription, unsubscribes and removes it from the executor when destroyed.
+	/// Blocks until the callback of the subscription is done, must not be destroyed from
+	/// its own callback. Handles must be destroyed before the executor.
+	/// @param T data type
+	template<typename T>
+	class subscription {
+	private:
+		executor* _ex; ///< owner executor
+		task*     _t;  ///< subscription task
+		sub<T>*   _s;  ///< subscriber (owned by the task)
+
+	public:
+		subscription() : _ex(nullptr), _t(nullptr), _s(nullptr) {}
+		subscription(executor* ex, task* t, sub<T>* s) : _ex(ex), _t(t), _s(s) {}
+
+		subscription(subscription&& o) noexcept : _ex(o._ex), _t(o._t), _s(o._s)
+		{
+			o._ex = nullptr; o._t = nullptr; o._s = nullptr;
+		}
+
+		subscription& operator=(subscription&& o) noexcept
+		{
+			if (this != &o) {
+				reset();
+				std::swap(_ex, o._ex); std::swap(_t, o._t); std::swap(_s, o._s);
+			}
+			return *this;
+		}
+
+		~subscription() { reset(); }
+
+		// No copies
+		subscription(const subscription&) = delete;
+		subscription& operator=(const subscription&) = delete;
+
+		/// Unsubscribe and remove the subscription from the executor
+		void reset()
+		{
+			if (_t) _ex->remove(_t);
+			_ex = nullptr; _t = nullptr; _s = nullptr;
+		}
+
+		/// Access the subscriber
+		sub<T>* get() const { return _s; }
+		sub<T>* operator->() const { return _s; }
+		sub<T>& operator*() const { return *_s; }
+		explicit operator bool() const { return _s != nullptr; }
+	};
+
+	/// Create subscription.
+	/// Subscribes to the topic and runs the callback on the workers for each entry.
+	/// The callback must not throw and must not keep references to the data.
+	/// The subscription is removed when the returned handle is destroyed.
+	/// @param[in] vd reference to the domain
+	/// @param[in] name subscriber name
+	/// @param[in] topic_name topic name
+	/// @param[in] fn callback, void fn(const T&)
+	/// @param[in] p priority class
+	/// @param[in] qsize size of the queue
+	/// @param[in] qos subscriber QoS
+	/// @return subscription handle
+	template<typename T>
+	subscription<T> subscribe(domain& vd, const std::string& name, const std::string& topic_name,
+			std::function<void(const T&)> fn, priority p = priority::normal,
+			size_t qsize = 16, const sub_qos& qos = sub_qos())
+	{
+		// Task is registered once the subscriber is created (the constructor may throw)
+		auto nt = make_task(p);
+		auto s = std::make_shared<sub<T>>(vd, name, topic_name, qsize, nt.get(), qos);
+		sub<T>* sp = s.get();
+		nt->run = [sp, fn](size_t max) { return sp->drain(fn, max); };
+		nt->detach = [sp]() { sp->queue()->detach(); };
+		nt->owner = std::move(s);
+		task* t = add(std::move(nt));
+
+		// Notifications are held off until the callback is set, run once to catch up
+		schedule(t);
+		return subscription<T>(this, t, sp);
+	}
+
+	/// Get number of worker threads
+	size_t size() const { return _workers.size(); }
+
+	/// Get total number of subscription runs
+	uint64_t run_count() const;
+
+	/// Get total number of stolen subscription runs
+	uint64_t steal_count() const;
+};
+
+} // namespace vdds
+
+#endif // VDDS_EXECUTOR_HPP
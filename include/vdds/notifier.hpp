@@ -31,12 +31,37 @@
 #ifndef VDDS_NOTIFIER_HPP
 #define VDDS_NOTIFIER_HPP
 
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include <thread>
+#include <climits>
+#include <cstdlib>
+#include <algorithm>
+#include <system_error>
 #include <condition_variable>
 
 namespace vdds {
+namespace detail {
+
+/// Spin-wait hint for the cpu
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace detail
 
 /// Notifer interface.
 /// Used for waking up subscriber threads.
@@ -128,6 +153,303 @@ public:
 	}
 };
 
+/// Futex notifier.
+/// Same semantics as notifier_cv without the mutex and the condition variable.
+/// Notify is a single atomic op while the subscriber is busy, the futex is woken
+/// up only when the subscriber is sleeping.
+class notifier_futex : public notifier {
+protected:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr uint32_t signaled = 1; ///> notification is pending
+	static constexpr uint32_t waiting  = 2; ///> subscriber is sleeping on the futex
+
+	std::atomic<uint32_t> _state; ///> futex word (signaled | waiting)
+	std::atomic<int64_t>  _ft;    ///> forced timeout in nanoseconds (during shutdown)
+
+	void wake(int n)
+	{
+		syscall(SYS_futex, &_state, FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+	}
+
+	/// Check for pending notification (does not consume it)
+	bool pending() const { return _state.load(std::memory_order_acquire) & signaled; }
+
+	/// Consume pending notification
+	/// @return true if the notification was pending
+	bool consume() { return _state.exchange(0, std::memory_order_acq_rel) & signaled; }
+
+	/// Apply forced timeout (shutdown)
+	std::chrono::nanoseconds timeout(std::chrono::nanoseconds t) const
+	{
+		int64_t ft = _ft.load(std::memory_order_relaxed);
+		return ft ? std::chrono::nanoseconds(ft) : t;
+	}
+
+	/// Sleep on the futex until notification or deadline.
+	/// Does not consume the notification.
+	/// @return true if notification is pending
+	bool sleep_until(clock::time_point deadline)
+	{
+		while (true) {
+			// Announce the sleep, notify() may have raced in
+			uint32_t s = 0;
+			if (!_state.compare_exchange_strong(s, waiting, std::memory_order_acquire) && (s & signaled))
+				return true;
+
+			auto left = deadline - clock::now();
+			if (left <= std::chrono::nanoseconds(0))
+				break;
+
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+			struct timespec ts = { time_t(ns / 1000000000), long(ns % 1000000000) };
+			syscall(SYS_futex, &_state, FUTEX_WAIT_PRIVATE, waiting, &ts, nullptr, 0);
+
+			if (pending())
+				return true;
+		}
+
+		// Drop the waiter flag, notify() does not need to wake us up anymore
+		return _state.fetch_and(signaled, std::memory_order_acq_rel) & signaled;
+	}
+
+	notifier_futex(const std::string& name) : notifier(name), _state(0), _ft(0) {}
+
+public:
+	notifier_futex() : notifier_futex("futex") {}
+
+	/// Wait for notification or timeout.
+	/// @param[in] t timeout (chrono duration)
+	void wait_for(std::chrono::nanoseconds t) override
+	{
+		if (consume())
+			return;
+
+		sleep_until(clock::now() + timeout(t));
+		consume();
+	}
+
+	/// Wake up subscriber.
+	/// Called from queue::push.
+	void notify() override
+	{
+		if (_state.fetch_or(signaled, std::memory_order_release) & waiting)
+			wake(1);
+	}
+
+	/// Wake up subscriber and set new timeout.
+	/// Called from queue::shutdown.
+	/// @param[in] ft timeout (chrono duration)
+	void shutdown(std::chrono::nanoseconds ft) override
+	{
+		_ft.store(ft.count(), std::memory_order_relaxed);
+		_state.fetch_or(signaled, std::memory_order_release);
+		wake(INT_MAX);
+	}
+};
+
+/// Eventfd notifier.
+/// Exposes a file descriptor that becomes readable when the subscriber queues have data,
+/// so that the subscribers can be multiplexed with other I/O in epoll/poll based event loops.
+/// Writes are coalesced: a burst of pushes costs one write until the subscriber calls reset().
+/// Event loops must call reset() before draining the queues once the fd is readable.
+class notifier_eventfd : public notifier {
+private:
+	int                  _fd;      ///> eventfd
+	std::atomic<bool>    _pending; ///> eventfd was written and not reset yet
+	std::atomic<int64_t> _ft;      ///> forced timeout in nanoseconds (during shutdown)
+
+	void signal()
+	{
+		uint64_t v = 1;
+		ssize_t r = ::write(_fd, &v, sizeof(v));
+		(void) r; // can only fail if the counter overflows, the fd is readable then anyway
+	}
+
+public:
+	notifier_eventfd() : notifier("eventfd"), _pending(false), _ft(0)
+	{
+		_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (_fd < 0)
+			throw std::system_error(errno, std::system_category(), "eventfd");
+	}
+
+	~notifier_eventfd() { ::close(_fd); }
+
+	/// Get file descriptor (for epoll, poll, etc).
+	/// Readable when there is a notification pending.
+	int fd() const { return _fd; }
+
+	/// Consume pending notification.
+	/// Must be called before draining the queues, pushes that race with the drain
+	/// make the fd readable again.
+	void reset()
+	{
+		uint64_t v;
+		ssize_t r = ::read(_fd, &v, sizeof(v));
+		(void) r; // EAGAIN if nothing is pending
+		_pending.store(false, std::memory_order_relaxed);
+
+		// Order the store against the subsequent queue pops (pairs with notify)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+
+	/// Wait for notification or timeout.
+	/// Consumes the notification.
+	/// @param[in] t timeout (chrono duration)
+	void wait_for(std::chrono::nanoseconds t) override
+	{
+		int64_t ft = _ft.load(std::memory_order_relaxed);
+		if (ft) t = std::chrono::nanoseconds(ft);
+
+		struct pollfd pfd = { _fd, POLLIN, 0 };
+		struct timespec ts = { time_t(t.count() / 1000000000), long(t.count() % 1000000000) };
+		ppoll(&pfd, 1, &ts, nullptr);
+		reset();
+	}
+
+	/// Wake up subscriber.
+	/// Called from queue::push. Writes the eventfd only if there is no notification pending.
+	void notify() override
+	{
+		// Order the preceding queue push against the load (pairs with reset)
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!_pending.load(std::memory_order_relaxed) && !_pending.exchange(true, std::memory_order_relaxed))
+			signal();
+	}
+
+	/// Wake up subscriber and set new timeout.
+	/// Called from queue::shutdown.
+	/// @param[in] ft timeout (chrono duration)
+	void shutdown(std::chrono::nanoseconds ft) override
+	{
+		_ft.store(ft.count(), std::memory_order_relaxed);
+		_pending.store(true, std::memory_order_relaxed);
+		signal();
+	}
+};
+
+/// Adaptive spin-then-block notifier.
+/// Futex notifier for low-latency subscribers of periodic topics. Tracks the average interval
+/// between the notifications and predicts the next one. The subscriber sleeps on the futex
+/// until shortly before the predicted arrival and busy-polls around it, so that the wakeup
+/// cost is paid only when the data is off the prediction. The polling window follows the
+/// observed jitter of the intervals (up to the max spin time), and the futex timer slack is
+/// compensated. Without a prediction (first wait) it busy-polls for the max spin time and
+/// then blocks.
+/// Publishers never issue a syscall while the subscriber is polling.
+/// The notifier is meant for a single subscriber thread.
+class notifier_adaptive : public notifier_futex {
+private:
+	std::chrono::nanoseconds _max_spin;  ///> max busy-poll time per wait
+	clock::time_point        _last;      ///> time of the last notification
+	int64_t                  _interval;  ///> average interval between notifications (nsec, 0 - unknown)
+	int64_t                  _jitter;    ///> average deviation of the intervals from the average (nsec)
+	int64_t                  _slack;     ///> average futex oversleep (nsec)
+	uint64_t                 _spin_hits; ///> number of notifications caught while polling
+	uint64_t                 _sleeps;    ///> number of futex sleeps
+
+	/// Busy-poll until notification or deadline
+	bool spin_until(clock::time_point deadline)
+	{
+		while (!pending()) {
+			if (clock::now() >= deadline) return false;
+			for (unsigned int i=0; i<16; i++) detail::cpu_relax();
+		}
+		return true;
+	}
+
+	/// Update the interval estimates (moving averages over 8 samples)
+	void arrived(clock::time_point now)
+	{
+		int64_t d = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _last).count();
+		_last = now;
+
+		// Gaps much longer than the estimate are outliers (idle topic, missed period)
+		if (!_interval || d > _interval * 4) {
+			_interval = d;
+			return;
+		}
+
+		_jitter += (std::abs(d - _interval) - _jitter) / 8;
+		_interval += (d - _interval) / 8;
+	}
+
+	/// Sleep until the polling window, compensating for the timer slack
+	/// @return true if notification is pending
+	bool sleep_before(clock::time_point t)
+	{
+		_sleeps++;
+		if (sleep_until(t - std::chrono::nanoseconds(_slack)))
+			return true;
+
+		int64_t over = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t).count() + _slack;
+		_slack += (std::max<int64_t>(over, 0) - _slack) / 8;
+		return false;
+	}
+
+public:
+	/// Create adaptive notifier.
+	/// Busy-polling is disabled on single cpu systems.
+	/// @param max_spin max busy-poll time per wait (cpu budget)
+	explicit notifier_adaptive(std::chrono::nanoseconds max_spin = std::chrono::microseconds(50)) :
+		notifier_futex("adaptive"), _max_spin(max_spin), _last(clock::now()), _interval(0),
+		_jitter(0), _slack(0), _spin_hits(0), _sleeps(0)
+	{
+		// Polling on a single cpu only delays the publisher
+		if (std::thread::hardware_concurrency() < 2)
+			_max_spin = std::chrono::nanoseconds(0);
+	}
+
+	/// Get current interval estimate
+	std::chrono::nanoseconds interval() const { return std::chrono::nanoseconds(_interval); }
+
+	/// Get number of notifications caught while busy-polling
+	uint64_t spin_hits() const { return _spin_hits; }
+
+	/// Get number of futex sleeps
+	uint64_t sleeps() const { return _sleeps; }
+
+	/// Wait for notification or timeout.
+	/// @param[in] t timeout (chrono duration)
+	void wait_for(std::chrono::nanoseconds t) override
+	{
+		auto now = clock::now();
+
+		if (consume()) {
+			arrived(now);
+			return;
+		}
+
+		auto deadline = now + timeout(t);
+		bool forced = _ft.load(std::memory_order_relaxed);
+
+		// Polling window around the predicted arrival (or right away without a prediction)
+		auto spin_start = now;
+		auto spin_end = now + _max_spin;
+		if (_interval && _max_spin.count() && !forced) {
+			auto expected = _last + std::chrono::nanoseconds(_interval);
+			auto w = std::chrono::nanoseconds(std::min<int64_t>(_jitter * 2 + 1000, _max_spin.count() / 2));
+			spin_start = std::max(now, expected - w);
+			spin_end = std::max(spin_start, expected + w);
+		}
+		spin_start = std::min(spin_start, deadline);
+		spin_end   = std::min(spin_end, deadline);
+
+		if (spin_start > now && sleep_before(spin_start)) {
+			// Early data, woken up by the publisher
+		} else if (spin_until(spin_end)) {
+			_spin_hits++;
+		} else if (spin_end < deadline) {
+			_sleeps++;
+			sleep_until(deadline);
+		}
+
+		if (consume())
+			arrived(clock::now());
+	}
+};
+
 } // namespace vdds
 
 #endif // VDDS_NOTIFIER_HPP
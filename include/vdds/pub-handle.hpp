@@ -40,18 +40,27 @@ class pub_handle {
 private:
 	const std::string _name; ///> publisher name
 	const char*  _trace_fmt; ///> trace format string
+	const char*  _batch_trace_fmt; ///> trace format string for batch push
+	unsigned int _lane;      ///> lane index in the subscriber queues (lanes mode)
 
 public:
 	/// Init publisher handle
 	/// @param name publisher name
 	/// @param tn topic name
-	explicit pub_handle(const std::string& name, const std::string& tn);
+	/// @param lane lane index
+	explicit pub_handle(const std::string& name, const std::string& tn, unsigned int lane = 0);
 
 	/// Get publisher name
 	const std::string& name() const { return _name; }
 
+	/// Get lane index
+	unsigned int lane() const { return _lane; }
+
 	/// Get trace format string
 	const char* trace_fmt() const { return _trace_fmt; }
+
+	/// Get batch trace format string
+	const char* batch_trace_fmt() const { return _batch_trace_fmt; }
 };
 
 } // namespace vdds
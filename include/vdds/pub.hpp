@@ -48,14 +48,60 @@
 
 namespace vdds {
 
+/// Loaned sample.
+/// Writable sample handle returned by vdds::pub::loan().
+/// The publisher fills the sample in place and publishes it with commit().
+/// The sample is returned to the pool if it's not committed.
+/// @param T data type
+template<typename T>
+class loaned {
+private:
+	using topic  = vdds::basic_topic<typename T::slot_type>;
+	using sample = vdds::basic_sample<typename T::slot_type>;
+
+	topic*            _topic;  ///> topic pointer
+	vdds::pub_handle* _handle; ///> publisher handle
+	sample*           _s;      ///> sample pointer
+
+public:
+	loaned(topic* t, vdds::pub_handle* ph, sample* s) : _topic(t), _handle(ph), _s(s) {}
+	~loaned() { if (_s) _s->pool->put(_s); }
+
+	// No copies (move only)
+	loaned(const loaned&) = delete;
+	loaned& operator=(const loaned&) = delete;
+
+	loaned(loaned&& l) : _topic(l._topic), _handle(l._handle), _s(l._s) { l._s = nullptr; }
+
+	/// Check if the loan is valid
+	explicit operator bool() const { return _s != nullptr; }
+
+	/// Access the data
+	T& operator*()  { return static_cast<T&>(_s->d); }
+	T* operator->() { return static_cast<T*>(&_s->d); }
+
+	/// Publish the sample to all subscribers.
+	/// The handle is invalid after this call. Noop for the invalid handles (failed loan,
+	/// committed already).
+	void commit()
+	{
+		if (!_s) return;
+		_topic->commit(_handle, _s);
+		_s = nullptr;
+	}
+};
+
 /// Typesafe publisher.
 /// Main publisher interface. Takes care of creating topic and publishing data.
 /// @param T data type
 template<typename T>
 class pub {
+public:
+	using data = typename T::slot_type; ///< data size class
+
 private:
-	vdds::pub_handle* _handle; ///> subscriber handle
-	vdds::topic*      _topic;  ///> topic pointer
+	vdds::pub_handle*        _handle; ///> subscriber handle
+	vdds::basic_topic<data>* _topic;  ///> topic pointer
 
 public:
 	/// Create publisher.
@@ -64,7 +110,7 @@ public:
 	{
 		static_assert(sizeof(T) == sizeof(data), "data type size missmatch");
 
-		_topic  = vd.create_topic(topic_name, T::data_type);
+		_topic  = vd.create_topic<data>(topic_name, T::data_type);
 		if (!_topic)
 			throw std::logic_error("failed to create topic");
 
@@ -87,11 +133,35 @@ public:
 	const std::string& data_type() const { return _topic->data_type(); }
 
 	/// Get topic pointer
-	vdds::topic* topic() { return _topic; }
+	vdds::basic_topic<data>* topic() { return _topic; }
 
 	/// Push data to all subscribers.
+	/// May block up to max blocking time of the reliable subscribers (@see vdds::sub_qos).
 	/// @param d ref to data.
-	void push(T& d) { _topic->push(_handle, static_cast<data&>(d)); }
+	/// @return number of the reliable subscribers that timed out
+	size_t push(T& d) { return _topic->push(_handle, static_cast<data&>(d)); }
+
+	/// Push data to all subscribers.
+	/// @param d ref to data.
+	/// @param[out] timed_out reliable subscriber queues that timed out are appended to this list
+	/// @return number of the reliable subscribers that timed out
+	size_t push(T& d, std::vector<const vdds::basic_sub_queue<data>*>& timed_out)
+	{
+		return _topic->push(_handle, static_cast<data&>(d), &timed_out);
+	}
+
+	/// Push batch of data to all subscribers.
+	/// Seqno range, topic cache reference and subscriber notifications are
+	/// taken once for the whole batch.
+	/// @param first pointer to the first entry
+	/// @param n number of entries
+	/// @return number of the reliable subscribers that timed out
+	size_t push_batch(T* first, size_t n) { return _topic->push_batch(_handle, static_cast<data*>(first), n); }
+
+	/// Loan a sample for zero-copy publishing.
+	/// Requires topic with sample pool (@see vdds::topic_qos).
+	/// @return loaned sample handle (invalid if the pool is disabled or exhausted)
+	vdds::loaned<T> loan() { return vdds::loaned<T>(_topic, _handle, _topic->loan()); }
 };
 
 } // namespace vdds
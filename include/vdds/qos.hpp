@@ -0,0 +1,131 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_QOS_HPP
+#define VDDS_QOS_HPP
+
+#include <stdint.h>
+#include <chrono>
+#include <functional>
+
+namespace vdds {
+
+struct plain_header;
+
+/// Topic QoS settings.
+/// Topic QoS is set by the first vdds::domain::create_topic() call for the topic.
+/// Settings passed to subsequent calls (including implicit calls from pub & sub) are ignored.
+struct topic_qos {
+	unsigned int pool_size  = 0; ///< number of pooled samples for zero-copy publishing (0 - disabled)
+	unsigned int ring_depth = 0; ///< depth of the broadcast ring shared by all subscribers (0 - disabled)
+	unsigned int durability_depth = 0; ///< number of last samples delivered to late-joining subscribers (0 - volatile)
+};
+
+/// Subscriber QoS settings.
+struct sub_qos {
+	/// Multi-publisher push mode
+	enum class mpub {
+		lock,     ///< single-producer queue, pushes from multiple publishers are serialized with a mutex
+		lockfree, ///< bounded lock-free multi-producer queue
+		lanes     ///< single-producer lane per publisher, lanes are merged on pop
+	};
+
+	/// Lane merge order (lanes mode)
+	enum class lane_order {
+		seqno,      ///< pop the oldest (lowest seqno) data across all lanes
+		round_robin ///< pop one entry from each non-empty lane in turn
+	};
+
+	/// History policy (what to do when the queue is full)
+	enum class history_policy {
+		drop_newest, ///< drop the new data
+		keep_last    ///< overwrite the oldest data, the queue holds the last qsize entries
+	};
+
+	/// Queue memory placement (NUMA)
+	enum class numa_policy {
+		none,  ///< regular heap, pages land on the node of the thread calling subscribe
+		local, ///< node of the consumer thread, slots are bound on the first pop (or vdds::sub::bind_local)
+		node   ///< explicit node (numa_node)
+	};
+
+	/// Reliability policy
+	enum class reliability_policy {
+		best_effort, ///< publishers never wait, data is dropped (or overwritten) when the queue is full
+		reliable     ///< publishers wait for room in the queue up to max_blocking
+	};
+
+	/// How reliable publishers wait for room in the queue
+	enum class backpressure {
+		spin,  ///< busy-wait
+		yield, ///< yield the cpu between retries
+		wait   ///< block on a notifier signaled by the subscriber
+	};
+
+	mpub multi_pub = mpub::lock;          ///< multi-publisher push mode (topics without sample pool and ring)
+	lane_order order = lane_order::seqno; ///< lane merge order (lanes mode)
+	unsigned int max_lanes = 4;           ///< max number of lanes, extra publishers share the last lane (lanes mode)
+	history_policy history = history_policy::drop_newest; ///< history policy (keep_last is not supported with sample pool and ring)
+	reliability_policy reliability = reliability_policy::best_effort; ///< reliability (reliable requires drop_newest history and a topic without sample pool and ring)
+	backpressure wait = backpressure::wait; ///< how publishers wait for room (reliable)
+	std::chrono::nanoseconds max_blocking = std::chrono::milliseconds(10); ///< max time publishers wait for room (reliable)
+
+	/// Content filter (empty - accept everything).
+	/// Gets the data header of the topic data size class, typed filters are set with vdds::sub.
+	/// Evaluated by the publishers before the data is pushed into the queue, rejected data
+	/// takes no queue slot and does not wake up the subscriber. Subscribers of the topics with
+	/// broadcast ring share the ring slots, the filter is evaluated on pop instead.
+	/// Called concurrently from all publisher threads, must be thread-safe and must not throw.
+	std::function<bool(const plain_header&)> filter;
+
+	/// Decimation and rate limiting (applied to the data accepted by the content filter).
+	/// Enforced by the publishers the same way as the content filter. Min interval is
+	/// measured with data::timestamp, publishers are expected to use a monotonic timebase.
+	unsigned int decimation = 1;                   ///< deliver every Nth sample (0, 1 - every sample)
+	std::chrono::nanoseconds min_interval{0};      ///< min timestamp delta between delivered samples (0 - disabled)
+
+	/// Queue slot allocation (fifo, lanes and pooled sample queues).
+	/// Placement is a preference, the kernel falls back to other nodes under memory pressure.
+	numa_policy numa = numa_policy::none; ///< NUMA placement of the queue slots
+	int numa_node = 0;                    ///< NUMA node (numa_policy::node)
+	bool hugepages = false;               ///< back the queue slots with 2MB hugepages (for deep queues)
+};
+
+/// Validate topic QoS.
+/// Sample pool and broadcast ring are mutually exclusive.
+/// @return true if the QoS settings are valid
+inline bool valid(const topic_qos& q)
+{
+	return !(q.pool_size && q.ring_depth);
+}
+
+} // namespace vdds
+
+#endif // VDDS_QOS_HPP
@@ -48,23 +48,40 @@ struct sub_info {
 	std::string name;    ///> subscriber name
 	uint32_t push_count; ///> number of pushed data messages
 	uint32_t drop_count; ///> number of dropped data messages
+	uint32_t overwrite_count; ///> number of overwritten data messages (keep_last history)
+	uint32_t filter_count; ///> number of data messages rejected by the content filter
+	uint32_t decimate_count; ///> number of data messages skipped by decimation and rate limiting
 	uint32_t qcapacity;  ///> queue capacity
 	uint32_t qsize;      ///> queue size (number of queued elements)
+	std::vector<uint32_t> lane_drop_count; ///> per-lane drop counts (lanes mode, empty otherwise)
 };
 
 /// Topic info.
 struct topic_info {
 	std::string name;      ///> topic name
 	std::string data_type; ///> data type name
+	uint32_t slot_size;    ///> data size class (bytes)
 	std::vector<sub_info> subs; ///> vector of subscribers
 	std::vector<pub_info> pubs; ///> vector of publishers
 	uint64_t push_count;   ///> number of pushed data messages
 };
 
+/// Buffer pool info.
+struct pool_info {
+	std::string name;         ///> pool name
+	uint32_t count;           ///> number of buffers
+	uint32_t buffer_size;     ///> buffer size
+	bool     hugepages;       ///> backed by explicit hugepages
+	uint64_t hit_count;       ///> number of get ops served from the thread caches
+	uint64_t miss_count;      ///> number of get ops served from the global free list
+	uint64_t exhausted_count; ///> number of failed get ops (pool was empty)
+};
+
 /// Domain info.
 struct domain_info {
 	std::string name; ///> Domain name
 	std::vector<topic_info> topics; ///> vector of topics
+	std::vector<pool_info> pools;   ///> vector of buffer pools
 };
 
 /// Query filter.
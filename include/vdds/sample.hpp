@@ -0,0 +1,187 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_SAMPLE_HPP
+#define VDDS_SAMPLE_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+#include "detail/free-list.hpp"
+#include "detail/aligned.hpp"
+#include "data.hpp"
+
+namespace vdds {
+
+template<typename D>
+class basic_sample_pool;
+
+/// Pooled sample.
+/// Data slot with intrusive reference count allocated from the sample pool.
+/// Used for zero-copy publishing where subscriber queues carry sample references
+/// instead of data copies.
+/// @param D data size class
+template<typename D>
+struct alignas(64) basic_sample : detail::aligned_new<basic_sample<D>> {
+	D d;                          ///< sample data
+	std::atomic<uint32_t> refcnt; ///< reference count
+	basic_sample_pool<D>* pool;   ///< owner pool
+};
+
+/// Sample pool.
+/// Fixed number of samples with a lock-free free list.
+/// @param D data size class
+template<typename D>
+class basic_sample_pool {
+private:
+	using sample = basic_sample<D>;
+
+	std::unique_ptr<sample[]> _samples;   ///> sample storage
+	detail::free_list         _free;      ///> list of free samples
+	std::atomic<uint64_t>     _exhausted; ///> number of failed get ops (pool was empty)
+
+	/// Drop shared payload (noop for plain-only data)
+	static void reset(data_header& d) { d.shared.reset(); }
+	static void reset(plain_header& d) { }
+
+	/// Validate pool size (before anything is allocated)
+	static size_t valid_size(size_t n);
+
+	/// Return sample to the free list
+	void release(sample* s)
+	{
+		reset(s->d);
+		_free.push(static_cast<uint32_t>(s - &_samples[0]));
+	}
+
+public:
+	/// Create sample pool
+	/// @param n number of samples
+	explicit basic_sample_pool(size_t n);
+
+	// No copies
+	basic_sample_pool(const basic_sample_pool&) = delete;
+	basic_sample_pool& operator=(const basic_sample_pool&) = delete;
+
+	/// Get pool capacity.
+	/// @return total number of samples (free list capacity)
+	size_t size() const { return _free.size(); }
+
+	/// Get number of free samples.
+	/// Snapshot for the stats and dumps, scans the samples.
+	size_t available() const
+	{
+		size_t n = 0;
+		for (size_t i = 0; i < size(); i++)
+			n += _samples[i].refcnt.load(std::memory_order_relaxed) == 0;
+		return n;
+	}
+
+	/// Get number of failed get ops
+	uint64_t exhausted_count() const { return _exhausted.load(std::memory_order_relaxed); }
+
+	/// Get sample.
+	/// Lockfree and nonblocking.
+	/// @return pointer to the sample with refcount set to one, or nullptr if the pool is empty
+	sample* get()
+	{
+		uint32_t i;
+		if (!_free.pop(i)) {
+			_exhausted.fetch_add(1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		sample* s = &_samples[i];
+		s->refcnt.store(1, std::memory_order_relaxed);
+		return s;
+	}
+
+	/// Drop sample references.
+	/// Sample is returned to the pool when the last reference is dropped.
+	/// @param s sample pointer
+	/// @param n number of references to drop
+	void put(sample* s, uint32_t n = 1)
+	{
+		if (s->refcnt.fetch_sub(n, std::memory_order_acq_rel) == n)
+			release(s);
+	}
+};
+
+using sample      = basic_sample<data>;
+using sample_pool = basic_sample_pool<data>;
+
+/// Sample reference.
+/// Read-only reference to a pooled sample received by the subscriber.
+/// The sample is returned to the pool when the last reference is dropped.
+/// @param T data type
+template<typename T>
+class sample_ref {
+private:
+	using sample = basic_sample<typename T::slot_type>;
+
+	sample* _s; ///> sample pointer
+
+public:
+	sample_ref() : _s(nullptr) {}
+	explicit sample_ref(sample* s) : _s(s) {}
+	~sample_ref() { reset(); }
+
+	// No copies (move only)
+	sample_ref(const sample_ref&) = delete;
+	sample_ref& operator=(const sample_ref&) = delete;
+
+	sample_ref(sample_ref&& r) : _s(r._s) { r._s = nullptr; }
+	sample_ref& operator=(sample_ref&& r)
+	{
+		if (this != &r) { reset(r._s); r._s = nullptr; }
+		return *this;
+	}
+
+	/// Drop current reference and take over the new one
+	/// @param s sample pointer (reference is owned by sample_ref after this call)
+	void reset(sample* s = nullptr)
+	{
+		if (_s) _s->pool->put(_s);
+		_s = s;
+	}
+
+	/// Check if the reference is valid
+	explicit operator bool() const { return _s != nullptr; }
+
+	/// Access the data
+	const T& operator*() const  { return static_cast<const T&>(_s->d); }
+	const T* operator->() const { return static_cast<const T*>(&_s->d); }
+	const T* get() const { return _s ? static_cast<const T*>(&_s->d) : nullptr; }
+};
+
+} // namespace vdds
+
+#endif // VDDS_SAMPLE_HPP
@@ -0,0 +1,225 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_SHARED_HPP
+#define VDDS_SHARED_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace vdds {
+
+/// Generic shared data type.
+/// Polymorphic base of the shared payloads, managed with std::shared_ptr by default.
+struct shared_t {
+	virtual ~shared_t() { };
+};
+
+/// Intrusively refcounted shared data.
+/// Opt-in base for the shared payloads that keep the reference count in the object.
+/// No control block is allocated, and topics add the references for all subscribers
+/// with a single atomic op. The object is disposed when the last reference is dropped.
+struct intrusive_t : shared_t {
+	std::atomic<uint32_t> refcnt; ///< reference count
+
+	intrusive_t() : refcnt(0) {}
+
+	// No copies
+	intrusive_t(const intrusive_t&) = delete;
+	intrusive_t& operator=(const intrusive_t&) = delete;
+
+	/// Dispose the object.
+	/// Called when the last reference is dropped. Deletes the object by default,
+	/// pooled payloads override this to return the object to the pool.
+	virtual void dispose() noexcept { delete this; }
+
+	/// Add references
+	void retain(uint32_t n = 1) noexcept { refcnt.fetch_add(n, std::memory_order_relaxed); }
+
+	/// Drop references.
+	/// Disposes the object when the last reference is dropped.
+	void release(uint32_t n = 1) noexcept
+	{
+		if (refcnt.fetch_sub(n, std::memory_order_acq_rel) == n)
+			dispose();
+	}
+};
+
+/// Adopt tag.
+/// Copies made with this tag take over a reference added with shared_handle::add_ref()
+/// instead of adding their own.
+struct adopt_ref_t { explicit adopt_ref_t() = default; };
+constexpr adopt_ref_t adopt_ref{};
+
+/// Shared data handle.
+/// Holds either a payload owned by std::shared_ptr or a reference to an intrusive payload.
+/// Same size as std::shared_ptr. Intrusive payloads are stored as a tagged pointer without
+/// control block (aliasing std::shared_ptr with empty owner), the references are tracked
+/// in the object.
+/// @note vdds::data::shared used to be std::shared_ptr<shared_t> (vDDS 1.x). Assignment from
+/// std::shared_ptr, get(), use_count() and reset() work as before. std::static_pointer_cast
+/// and assignment to std::shared_ptr do not compile anymore, use static_cast on get()
+/// or to_shared_ptr<T>() instead.
+class shared_handle {
+private:
+	std::shared_ptr<shared_t> _sp; ///> payload owned by std::shared_ptr or tagged intrusive payload
+
+	static const uintptr_t intrusive_tag = 1;
+
+	/// Wrap intrusive payload (no control block, low bit tagged)
+	static std::shared_ptr<shared_t> tag(intrusive_t* p) noexcept
+	{
+		if (!p) return std::shared_ptr<shared_t>();
+		auto v = reinterpret_cast<uintptr_t>(static_cast<shared_t*>(p)) | intrusive_tag;
+		return std::shared_ptr<shared_t>(std::shared_ptr<shared_t>(), reinterpret_cast<shared_t*>(v));
+	}
+
+	/// Get intrusive payload (null if owned by std::shared_ptr)
+	intrusive_t* ip() const noexcept
+	{
+		auto v = reinterpret_cast<uintptr_t>(_sp.get());
+		if (!(v & intrusive_tag)) return nullptr;
+		return static_cast<intrusive_t*>(reinterpret_cast<shared_t*>(v & ~intrusive_tag));
+	}
+
+public:
+	shared_handle() noexcept {}
+	shared_handle(std::nullptr_t) noexcept {}
+
+	/// Take over payload owned by std::shared_ptr
+	template<typename U, typename = typename std::enable_if<std::is_convertible<U*, shared_t*>::value>::type>
+	shared_handle(std::shared_ptr<U> sp) noexcept : _sp(std::move(sp)) {}
+
+	/// Reference intrusive payload
+	explicit shared_handle(intrusive_t* p) noexcept : _sp(tag(p))
+	{
+		if (p) p->retain();
+	}
+
+	shared_handle(const shared_handle& h) noexcept : _sp(h._sp)
+	{
+		if (auto p = ip()) p->retain();
+	}
+
+	/// Copy that takes over one of the references added with add_ref().
+	/// Payloads owned by std::shared_ptr are copied as usual.
+	shared_handle(const shared_handle& h, adopt_ref_t) noexcept : _sp(h._sp) {}
+
+	shared_handle(shared_handle&& h) noexcept : _sp(std::move(h._sp)) {}
+
+	~shared_handle()
+	{
+		if (auto p = ip()) p->release();
+	}
+
+	shared_handle& operator=(shared_handle h) noexcept
+	{
+		swap(h);
+		return *this;
+	}
+
+	void swap(shared_handle& h) noexcept { _sp.swap(h._sp); }
+	void reset() noexcept { shared_handle().swap(*this); }
+
+	/// Check if the payload is intrusive
+	bool intrusive() const noexcept { return ip() != nullptr; }
+
+	/// Add references to the intrusive payload.
+	/// Used for the fan-out, the references are taken over by the copies made with adopt_ref.
+	/// Noop for the payloads owned by std::shared_ptr.
+	/// @param n number of references
+	void add_ref(uint32_t n) const noexcept
+	{
+		auto p = ip();
+		if (p && n) p->retain(n);
+	}
+
+	/// Drop references added with add_ref() that were not taken over.
+	/// @param n number of references
+	void drop_ref(uint32_t n) const noexcept
+	{
+		auto p = ip();
+		if (p && n) p->release(n);
+	}
+
+	/// Access the payload
+	shared_t* get() const noexcept
+	{
+		auto p = ip();
+		return p ? p : _sp.get();
+	}
+	shared_t* operator->() const noexcept { return get(); }
+	shared_t& operator*() const noexcept { return *get(); }
+	explicit operator bool() const noexcept { return _sp.get() != nullptr; }
+
+	/// Get the payload as std::shared_ptr.
+	/// Payloads owned by std::shared_ptr are returned as is. Intrusive payloads are wrapped
+	/// into a new std::shared_ptr (allocates a control block) that holds one reference.
+	/// @param U payload type
+	template<typename U = shared_t>
+	std::shared_ptr<U> to_shared_ptr() const
+	{
+		auto p = ip();
+		if (!p) return std::static_pointer_cast<U>(_sp);
+
+		p->retain();
+		return std::shared_ptr<U>(static_cast<U*>(static_cast<shared_t*>(p)), [p](U*) { p->release(); });
+	}
+
+	/// Get number of references
+	long use_count() const noexcept
+	{
+		auto p = ip();
+		return p ? p->refcnt.load(std::memory_order_relaxed) : _sp.use_count();
+	}
+
+	/// Atomic load.
+	/// Used for the broadcast ring slots. Serialized with atomic_store() with a striped lock,
+	/// so that the reference to the payload is taken before the writer can drop it.
+	/// The ring skips the call for the slots without shared payload.
+	/// @param h pointer to the handle
+	/// @return copy of the handle
+	static shared_handle atomic_load(const shared_handle* h);
+
+	/// Atomic store.
+	/// The previous payload reference is dropped outside of the critical section.
+	/// @param h pointer to the handle
+	/// @param v new value
+	static void atomic_store(shared_handle* h, shared_handle v);
+};
+
+static_assert(sizeof(shared_handle) == sizeof(std::shared_ptr<shared_t>), "unexpected shared handle size");
+
+} // namespace vdds
+
+#endif // VDDS_SHARED_HPP
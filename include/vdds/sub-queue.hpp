@@ -32,22 +32,89 @@
 #define VDDS_SUB_QUEUE_HPP
 
 #include <atomic>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <functional>
 
 #include "detail/spsc-queue.hpp"
+#include "detail/bcast-ring.hpp"
+#include "detail/mpsc-queue.hpp"
+#include "detail/placement.hpp"
+#include "detail/epoch.hpp"
+#include "detail/aligned.hpp"
 #include "data.hpp"
+#include "sample.hpp"
 #include "notifier.hpp"
+#include "qos.hpp"
 
 namespace vdds {
 
+/// Publish op state.
+/// Shared by the queue pushes of a single topic push (reliable mode).
+struct push_op {
+	/// Start of the op, set by the first wait for room (@see basic_sub_queue::deadline)
+	std::chrono::steady_clock::time_point start;
+
+	/// Called before the publisher blocks waiting for room, and once it's done waiting.
+	/// Topics leave the epoch critical section while the publisher is blocked (@see basic_topic::push).
+	virtual void suspend() {}
+	virtual void resume() {}
+};
+
 /// Subscriber queue.
 /// Simple single-read/write fifo based on vdds::spsc_queue.
 /// This queue is allocated for each subscriber for each topic.
-class sub_queue {
+/// Subscribers of the topics with sample pool use a fifo of sample references instead of data copies.
+/// Subscribers of the topics with broadcast ring keep only the read position in the shared ring.
+/// Subscribers in lanes mode have a private fifo (lane) per publisher.
+/// Queue slots are sized for the topic data size class.
+/// @param D data size class
+template<typename D>
+class basic_sub_queue : public detail::aligned_new<basic_sub_queue<D>> {
 private:
-	vdds::spsc_queue<data> _fifo;  ///> queue backend
+	using data   = D;
+	using sample = basic_sample<D>;
+
+	template<typename T>
+	using fifo_queue = vdds::spsc_queue<T, detail::slot_allocator<T>>;
+
+	/// Per-publisher lane
+	struct lane : detail::aligned_new<lane> {
+		fifo_queue<data> fifo; ///> lane fifo
+		uint32_t push_count;   ///> number of push ops
+		uint32_t drop_count;   ///> number of dropped push ops (lane was full)
+
+		explicit lane(size_t capacity, const detail::placement& p) :
+			fifo(capacity, detail::slot_allocator<data>(p)), push_count(0), drop_count(0) {}
+	};
+
+	detail::placement _placement; ///> queue slot placement
+	std::atomic<int>  _node;      ///> node the slots are bound to (deferred placement, -1 - not bound yet)
+	bool              _unbound;   ///> slots are waiting for the consumer thread (deferred placement)
+	fifo_queue<data> _fifo;       ///> queue backend
+	std::unique_ptr<fifo_queue<sample*>> _refs; ///> queue backend for pooled samples
+	std::unique_ptr<detail::mpsc_queue<data>>  _mpsc; ///> queue backend for lock-free multi-publisher push
+	std::atomic<uint32_t> _mpsc_drop_count;           ///> number of dropped push ops (mpsc backend)
+
+	std::unique_ptr<std::atomic<lane*>[]> _lanes; ///> lanes indexed by publisher lane (lanes backend)
+	unsigned int        _nlanes;  ///> number of lanes, the last lane is shared
+	unsigned int        _rr_lane; ///> next lane to pop from (round-robin order)
+	sub_qos::lane_order _order;   ///> lane merge order
+
+	std::unique_ptr<detail::bcast_ring<data>> _hist; ///> private ring (keep_last history)
+	std::atomic<uint64_t> _hist_head;                ///> private ring head (next position to be written)
+	uint32_t              _overwrite_count;          ///> number of overwritten entries (keep_last history)
+
+	detail::bcast_ring<data>*    _ring;   ///> broadcast ring (topic ring mode)
+	const std::atomic<uint64_t>* _head;   ///> ring head (next position to be written)
+	uint64_t                     _cursor; ///> ring read position
+	uint64_t                     _start;  ///> ring position at the time of subscription
 	uint32_t        _drop_count;   ///> number of dropped push ops (queue was full)
 	uint32_t        _push_count;   ///> number of push ops
-	vdds::notifier* _notifier;     ///> notifier pointer
+	std::atomic<vdds::notifier*> _notifier;  ///> notifier pointer (null once detached)
+	std::atomic<uint32_t>        _refcnt;    ///> references held by the topic caches (@see get)
 
 	const std::string  _name;      ///> queue name (subscriber name)
 	const std::string  _data_type; ///> data type name
@@ -56,20 +123,262 @@ private:
 	std::mutex         _mutex;     ///> mutex used for multi-publisher push
 
 	const char*        _trace_fmt; ///> trace format string
+	const char*        _drain_trace_fmt; ///> trace format string for drain
+
+	// Reliable mode state
+	bool                        _reliable;     ///> publishers wait for room instead of dropping
+	sub_qos::backpressure       _bp;           ///> how publishers wait for room
+	std::chrono::nanoseconds    _max_blocking; ///> max time publishers wait for room
+	std::unique_ptr<notifier_cv> _room;        ///> signaled by the subscriber when room is freed (wait mode)
+	std::atomic<uint32_t>       _waiters;      ///> number of publishers waiting on the room notifier
+
+	// Content filter state
+	std::function<bool(const plain_header&)> _filter;   ///> content filter (empty if disabled)
+	std::atomic<uint32_t>       _filter_count;  ///> number of rejected entries
+
+	// Decimation state
+	uint32_t                    _decimation;     ///> deliver every Nth entry (0, 1 - disabled)
+	uint64_t                    _min_interval;   ///> min timestamp delta in nanoseconds (0 - disabled)
+	std::atomic<uint32_t>       _decimate_seq;   ///> number of entries seen by decimation
+	std::atomic<uint64_t>       _next_timestamp; ///> earliest timestamp of the next delivered entry
+	std::atomic<uint32_t>       _decimate_count; ///> number of skipped entries
+
+	/// Apply decimation and rate limiting.
+	/// Lock-free, concurrent publishers race on the counter and the timestamp.
+	/// @return false if the entry is skipped
+	bool decimate(const data& d)
+	{
+		if (_decimation > 1 && _decimate_seq.fetch_add(1, std::memory_order_relaxed) % _decimation)
+			return false;
+
+		if (_min_interval) {
+			uint64_t next = _next_timestamp.load(std::memory_order_relaxed);
+			do {
+				if (d.timestamp < next) return false;
+			} while (!_next_timestamp.compare_exchange_weak(next, d.timestamp + _min_interval, std::memory_order_relaxed));
+		}
+		return true;
+	}
+
+	/// Get reliable push deadline.
+	/// The deadline is relative to the start of the publish op, which is shared by all queues
+	/// and runs of the op, so that the publisher is blocked up to max blocking time in total.
+	/// @param op publish op, the start is set by the first wait (null - starts now)
+	std::chrono::steady_clock::time_point deadline(push_op* op) const
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (!op) return now + _max_blocking;
+		if (op->start == std::chrono::steady_clock::time_point()) op->start = now;
+		return op->start + _max_blocking;
+	}
+
+	/// Suspends the publish op while the publisher is blocked (@see push_op)
+	struct suspend_guard {
+		push_op* op;
+		explicit suspend_guard(push_op* o) : op(o) { if (op) op->suspend(); }
+		~suspend_guard() { if (op) op->resume(); }
+	};
+
+	/// Wait for room in the queue (reliable mode).
+	/// Kicks the subscriber and retries the push until it succeeds or the deadline expires.
+	/// @param op publish op (null - not suspended)
+	/// @param try_push push op, returns true once everything is pushed
+	/// @return false if timed out
+	template<typename F>
+	bool wait_room(push_op* op, F&& try_push)
+	{
+		auto dl = deadline(op);
+		kick();
+
+		suspend_guard sg(op);
+
+		for (;;) {
+			auto now = std::chrono::steady_clock::now();
+			if (now >= dl) return try_push();
+
+			switch (_bp) {
+			case sub_qos::backpressure::spin:
+				break;
+			case sub_qos::backpressure::yield:
+				std::this_thread::yield();
+				break;
+			case sub_qos::backpressure::wait:
+				// Announce the waiter before the final check, pairs with the fence in room_freed()
+				_waiters.fetch_add(1, std::memory_order_seq_cst);
+				if (try_push()) {
+					_waiters.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+				_room->wait_for(dl - now);
+				_waiters.fetch_sub(1, std::memory_order_relaxed);
+				break;
+			}
+
+			if (try_push()) return true;
+		}
+	}
+
+	/// Signal freed room to the waiting publishers (reliable wait mode).
+	/// Costs a fence and a load when nobody is waiting.
+	void room_freed()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (_waiters.load(std::memory_order_relaxed))
+			_room->notify();
+	}
+
+	/// Push single entry.
+	/// Common part of the push ops (@see push).
+	/// @param li publisher lane index (lanes backend, out of range - shared lane)
+	/// @param need_lock lock flag for the other backends
+	/// @param op publish op
+	/// @param a slot constructor args, (d) or (d, adopt_ref)
+	/// @return false if the data was dropped
+	template<typename... A>
+	bool push_one(unsigned int li, bool need_lock, push_op* op, const A&... a)
+	{
+		if (_hist) {
+			bool r = _hist->store(_hist_head.fetch_add(1, std::memory_order_relaxed), a...);
+			kick();
+			return r;
+		}
+
+		if (_mpsc) {
+			bool r = _mpsc->emplace(a...);
+			if (!r && _reliable) r = wait_room(op, [&]() { return _mpsc->emplace(a...); });
+
+			// Stats: push count is derived from the queue, drops are rare
+			if (!r) _mpsc_drop_count.fetch_add(1, std::memory_order_relaxed);
+			kick();
+			return r;
+		}
+
+		if (_lanes) {
+			bool shared = li >= _nlanes - 1;
+			lane* l = _lanes[shared ? _nlanes - 1 : li].load(std::memory_order_acquire);
+
+			if (shared) _mutex.lock();
+
+			// Update stats and push into the lane
+			l->push_count++;
+			bool r = l->fifo.emplace(a...);
+			if (!r && !_reliable) l->drop_count++;
+
+			if (shared) _mutex.unlock();
+
+			if (!r && _reliable) {
+				r = wait_room(op, [&]() {
+					std::unique_lock<std::mutex> lk(_mutex, std::defer_lock);
+					if (shared) lk.lock();
+					return l->fifo.emplace(a...);
+				});
+
+				std::unique_lock<std::mutex> lk(_mutex, std::defer_lock);
+				if (shared) lk.lock();
+				if (!r) l->drop_count++;
+			}
+
+			kick();
+			return r;
+		}
+
+		if (need_lock) _mutex.lock();
+
+		// Update stats and push into fifo
+		_push_count++;
+		bool r = _fifo.emplace(a...);
+		if (!r && !_reliable) _drop_count++;
+
+		if (need_lock) _mutex.unlock();
+
+		if (!r && _reliable) {
+			r = wait_room(op, [&]() {
+				std::unique_lock<std::mutex> l(_mutex, std::defer_lock);
+				if (need_lock) l.lock();
+				return _fifo.emplace(a...);
+			});
+
+			std::unique_lock<std::mutex> l(_mutex, std::defer_lock);
+			if (need_lock) l.lock();
+			if (!r) _drop_count++;
+		}
+
+		kick(need_lock);
+		return r;
+	}
 
 public:
+	/// Queue backend
+	enum class backend {
+		fifo, ///< private fifo with data copies
+		mpsc, ///< private lock-free multi-producer fifo with data copies
+		lanes,///< private fifo per publisher with data copies, merged on pop
+		last, ///< private ring with data copies, overwrites the oldest data (keep_last history)
+		pool, ///< private fifo with pooled sample references
+		ring  ///< read position in the topic broadcast ring
+	};
+
 	/// Create subscriber queue
 	/// @param name queue name (subscriber name)
 	/// @param tn topic name
 	/// @param dt data type name
 	/// @param size queue size
 	/// @param n notifier pointer (null, cv, polling)
-	explicit sub_queue(const std::string& name, const std::string& tn,
-			const std::string& dt, size_t capacity = 16, notifier *n = nullptr);
+	/// @param b queue backend (ring queues must be attached to the ring before use)
+	/// @param qos subscriber QoS (lane and reliability settings)
+	explicit basic_sub_queue(const std::string& name, const std::string& tn,
+			const std::string& dt, size_t capacity = 16, notifier *n = nullptr, backend b = backend::fifo,
+			const sub_qos& qos = sub_qos());
+
+	/// Delete subscriber queue.
+	/// Drops references to the queued samples (if any).
+	~basic_sub_queue();
+
+	/// Attach the queue to the broadcast ring.
+	/// Called by the topic before the queue is published to the publishers.
+	/// @param r pointer to the ring
+	/// @param head pointer to the ring head (next position to be written)
+	/// @param backlog number of entries behind the head to start reading from (durable topics)
+	void attach(detail::bcast_ring<data>* r, const std::atomic<uint64_t>* head, uint64_t backlog = 0)
+	{
+		_ring   = r;
+		_head   = head;
+		_capacity = r->depth();
+
+		uint64_t h = head->load(std::memory_order_acquire);
+		_start  = _cursor = h - std::min<uint64_t>({ backlog, h, _capacity });
+	}
+
+	/// Add lane for the publisher.
+	/// Called by the topic (under the topic lock) before the publisher can push into this queue.
+	/// Noop if the lane already exists or the queue is not in lanes mode.
+	/// @param i publisher lane index
+	void add_lane(unsigned int i)
+	{
+		if (!_lanes) return;
+		i = std::min(i, _nlanes - 1);
+		if (_lanes[i].load(std::memory_order_relaxed)) return;
+
+		lane* l = new lane(_capacity, _placement);
+		_lanes[i].store(l, std::memory_order_seq_cst);
+
+		// Consumer may have bound the other lanes already (@see bind_local)
+		int node = _node.load(std::memory_order_seq_cst);
+		if (node >= 0) bind(l->fifo, node);
+	}
+
+	/// Bind queue slots to the NUMA node of the calling thread.
+	/// Applies to numa_policy::local queues, noop otherwise. Called automatically by
+	/// the first pop, must be called from the consumer thread.
+	void bind_local();
+
+	/// Get NUMA node of the queue slots.
+	/// @return node number, -1 if there is no preference or the slots are not bound yet
+	int node() const { return _placement.deferred ? _node.load(std::memory_order_relaxed) : _placement.node; }
 
 	// No copies
-	sub_queue(const sub_queue&) = delete;
-	sub_queue& operator=(const sub_queue&) = delete;
+	basic_sub_queue(const basic_sub_queue&) = delete;
+	basic_sub_queue& operator=(const basic_sub_queue&) = delete;
 
 	/// Get queue name and data type
 	const std::string& name() const { return _name; }
@@ -78,37 +387,277 @@ public:
 	/// Get trace format string
 	const char* trace_fmt() const { return _trace_fmt; }
 
+	/// Get drain trace format string
+	const char* drain_trace_fmt() const { return _drain_trace_fmt; }
+
 	/// Get notifier pointer
-	vdds::notifier* notifier() { return _notifier; }
+	vdds::notifier* notifier() { return _notifier.load(std::memory_order_relaxed); }
+
+	/// Add reference.
+	/// Queues are referenced by the topic caches that list them, and are deleted once
+	/// the last cache that lists them is reclaimed (@see basic_topic::unsubscribe).
+	void get() { _refcnt.fetch_add(1, std::memory_order_relaxed); }
+
+	/// Drop reference, deletes the queue when the last reference is dropped.
+	void put()
+	{
+		if (_refcnt.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete this;
+	}
+
+	/// Detach the notifier.
+	/// Publishers stop kicking the notifier, which may be destroyed once this call returns.
+	/// Publishers call into the notifier only within the epoch critical section, this call
+	/// waits for the grace period. Must be called outside of the critical section.
+	void detach()
+	{
+		// Already detached (and waited for) by the previous call
+		if (!_notifier.exchange(nullptr, std::memory_order_acq_rel)) return;
+		detail::epoch::synchronize();
+	}
+
+	/// Drop queued data.
+	/// Called by the consumer, same as drain() with a noop callback.
+	void flush()
+	{
+		_unbound = false;
+		drain([](const data&) {}, SIZE_MAX);
+	}
+
+	/// Check if the queue is reliable (publishers wait for room)
+	bool reliable() const { return _reliable; }
+
+	/// Check if the queue has publish-side filters (content filter, decimation)
+	bool has_filters() const { return _filter || _decimation > 1 || _min_interval; }
+
+	/// Evaluate publish-side filters.
+	/// Called by the topic before the data is pushed into the queue.
+	/// Rejected data is accounted in the filter count, skipped data in the decimate count.
+	/// @param[in] d ref to data
+	/// @return false if the data is rejected, true otherwise
+	bool accept(const data& d)
+	{
+		if (_filter && !_filter(d)) {
+			_filter_count.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		if ((_decimation > 1 || _min_interval) && !decimate(d)) {
+			_decimate_count.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
 
 	/// Get queue info (size, room, drop, etc)
+	/// Drop count of the ring subscribers is the number of overrun (lost) entries.
+	/// Overrun entries of the keep_last queues are accounted as overwrites.
+	/// Capacity of the queues in lanes mode is per lane, the other stats are totals across all lanes.
 	size_t capacity() const { return _capacity; }
-	size_t size() const { return _capacity - _fifo.write_available(); }
-	uint32_t push_count() const { return _push_count; }
-	uint32_t drop_count() const { return _drop_count; }
+	size_t size() const
+	{
+		if (_ring) return std::min<uint64_t>(_head->load(std::memory_order_relaxed) - _cursor, _capacity);
+		if (_mpsc) return _mpsc->size();
+		if (_lanes) return lane_sum([](const lane* l) -> size_t { return l->fifo.size(); });
+		return _capacity - (_refs ? _refs->write_available() : _fifo.write_available());
+	}
+	uint32_t push_count() const
+	{
+		if (_ring) return _head->load(std::memory_order_relaxed) - _start;
+		if (_mpsc) return _mpsc->push_count() + _mpsc_drop_count.load(std::memory_order_relaxed);
+		if (_lanes) return lane_sum([](const lane* l) -> size_t { return l->push_count; });
+		return _push_count;
+	}
+	uint32_t overwrite_count() const
+	{
+		if (!_hist) return _overwrite_count;
+
+		// Entries overwritten since the last pop are accounted by the consumer on the next pop
+		uint64_t n = _head->load(std::memory_order_relaxed) - _cursor;
+		return _overwrite_count + (n > _capacity ? n - _capacity : 0);
+	}
+	uint32_t filter_count() const { return _filter_count.load(std::memory_order_relaxed); }
+	uint32_t decimate_count() const { return _decimate_count.load(std::memory_order_relaxed); }
+	uint32_t drop_count() const
+	{
+		if (_mpsc) return _mpsc_drop_count.load(std::memory_order_relaxed);
+		if (_lanes) return lane_sum([](const lane* l) -> size_t { return l->drop_count; });
+		return _drop_count;
+	}
+
+	/// Get number of lanes (zero if the queue is not in lanes mode)
+	unsigned int lanes() const { return _lanes ? _nlanes : 0; }
+
+	/// Get number of dropped push ops in the lane
+	/// @param i lane index
+	uint32_t lane_drop_count(unsigned int i) const
+	{
+		const lane* l = _lanes[i].load(std::memory_order_acquire);
+		return l ? l->drop_count : 0;
+	}
 
 	/// Kick queue.
 	void kick(bool need_lock = false)
 	{
 		// CV notifier will do condition signal, noop otherwise
-		if (_notifier)
-			_notifier->notify();
+		with_notifier([](vdds::notifier* n) { n->notify(); });
 	}
 
 	/// Push data.
-	/// Lockfree and nonblocking for single-publisher case.
+	/// Lockfree and nonblocking for single-publisher case, and for any number
+	/// of publishers with the mpsc and keep_last backends.
+	/// Reliable queues block the caller until there is room in the queue or max blocking
+	/// time expires (@see sub_qos::reliability).
+	/// @param[in] d ref to data
+	/// @param[in] need_lock lock flag
+	/// @param[in,out] op publish op (reliable deadline, @see push_op)
+	/// @return false if the data was dropped, true otherwise
+	bool push(const data &d, bool need_lock = false, push_op* op = nullptr)
+	{
+		// Publisher lane is not known, use the shared lane
+		return push_one(~0u, need_lock, op, d);
+	}
+
+	/// Push data into the publisher lane.
+	/// Lockfree and nonblocking for the publishers with a dedicated lane. Publishers
+	/// that share the last lane are serialized with a mutex.
+	/// Same as push(d, need_lock) if the queue is not in lanes mode.
+	/// @param[in] d ref to data
+	/// @param[in] li publisher lane index
+	/// @param[in] need_lock lock flag for the other backends
+	/// @param[in,out] op publish op (reliable deadline, @see push_op)
+	/// @return false if the data was dropped, true otherwise
+	bool push(const data &d, unsigned int li, bool need_lock = false, push_op* op = nullptr)
+	{
+		return push_one(li, need_lock, op, d);
+	}
+
+	/// Push data, take over the shared payload reference.
+	/// Same as push(d, li, need_lock), except that the queued copy takes over one of
+	/// the references added by the caller with shared_handle::add_ref().
+	/// The reference is not taken over if the data was dropped.
 	/// @param[in] d ref to data
-	void push(const data &d, bool need_lock = false)
+	/// @param[in] li publisher lane index
+	/// @param[in] need_lock lock flag for the other backends
+	/// @param[in,out] op publish op (reliable deadline, @see push_op)
+	/// @return false if the data was dropped, true otherwise
+	bool push(const data &d, adopt_ref_t, unsigned int li, bool need_lock = false, push_op* op = nullptr)
+	{
+		return push_one(li, need_lock, op, d, adopt_ref);
+	}
+
+	/// Push data batch.
+	/// Same as push(d, li, need_lock) for each entry, except that the queue is not kicked.
+	/// The caller kicks the queue once for the whole batch. Reliable queues wait for
+	/// room up to max blocking time for the whole publish op (@see deadline).
+	/// @param[in] d pointer to the first entry
+	/// @param[in] n number of entries
+	/// @param[in] li publisher lane index
+	/// @param[in] need_lock lock flag
+	/// @param[in,out] op publish op (reliable deadline, @see push_op)
+	/// @return number of entries pushed, the rest is dropped
+	size_t push(const data* d, size_t n, unsigned int li, bool need_lock = false, push_op* op = nullptr)
+	{
+		size_t r = 0;
+
+		if (_hist) {
+			uint64_t pos = _hist_head.fetch_add(n, std::memory_order_relaxed);
+			for (size_t i = 0; i < n; i++) _hist->store(pos + i, d[i]);
+			return n;
+		}
+
+		if (_mpsc) {
+			auto mpsc_push = [&]() { r += _mpsc->push(d + r, n - r); return r == n; };
+			if (!mpsc_push() && _reliable) wait_room(op, mpsc_push);
+
+			if (r != n) _mpsc_drop_count.fetch_add(n - r, std::memory_order_relaxed);
+			return r;
+		}
+
+		if (_lanes) {
+			bool shared = li >= _nlanes - 1;
+			lane* l = _lanes[shared ? _nlanes - 1 : li].load(std::memory_order_acquire);
+
+			auto lane_push = [&]() {
+				std::unique_lock<std::mutex> lk(_mutex, std::defer_lock);
+				if (shared) lk.lock();
+				r += l->fifo.push(d + r, n - r);
+				return r == n;
+			};
+			if (!lane_push() && _reliable) wait_room(op, lane_push);
+
+			if (shared) _mutex.lock();
+			l->push_count += n;
+			l->drop_count += n - r;
+			if (shared) _mutex.unlock();
+			return r;
+		}
+
+		auto fifo_push = [&]() {
+			std::unique_lock<std::mutex> l(_mutex, std::defer_lock);
+			if (need_lock) l.lock();
+			r += _fifo.push(d + r, n - r);
+			return r == n;
+		};
+		if (!fifo_push() && _reliable) wait_room(op, fifo_push);
+
+		if (need_lock) _mutex.lock();
+		_push_count += n;
+		_drop_count += n - r;
+		if (need_lock) _mutex.unlock();
+		return r;
+	}
+
+	/// Drop data.
+	/// Accounts for the data that could not be pushed (sample pool exhausted).
+	/// @param[in] need_lock lock flag
+	/// @param[in] n number of dropped entries
+	void drop(bool need_lock = false, size_t n = 1)
+	{
+		if (need_lock) _mutex.lock();
+
+		_push_count += n;
+		_drop_count += n;
+
+		if (need_lock) _mutex.unlock();
+	}
+
+	/// Push sample reference.
+	/// Lockfree and nonblocking for single-publisher case.
+	/// Caller must hold the reference on behalf of this queue. The reference is
+	/// not consumed if the queue is full.
+	/// @param[in] s sample pointer
+	/// @return false if the queue is full, true otherwise
+	bool push(sample* s, bool need_lock = false)
 	{
 		if (need_lock) _mutex.lock();
 
 		// Update stats and push into fifo
 		_push_count++;
-		if (!_fifo.push(d)) _drop_count++;
+		bool r = _refs->push(s);
+		if (!r) _drop_count++;
 
 		if (need_lock) _mutex.unlock();
 
-		return kick(need_lock);
+		kick(need_lock);
+		return r;
+	}
+
+	/// Push batch of sample references.
+	/// Same as push(s, need_lock) for each entry, except that the queue is not kicked.
+	/// The caller kicks the queue once for the whole batch.
+	/// @param[in] s pointer to the array of sample pointers
+	/// @param[in] n number of samples
+	/// @return number of samples pushed, references of the rest are not consumed
+	size_t push(sample* const* s, size_t n, bool need_lock = false)
+	{
+		if (need_lock) _mutex.lock();
+
+		_push_count += n;
+		size_t r = _refs->push(s, n);
+		_drop_count += n - r;
+
+		if (need_lock) _mutex.unlock();
+		return r;
 	}
 
 	/// Pop data.
@@ -117,17 +666,178 @@ public:
 	/// @return false if queue is empty, true otherwise
 	bool pop(data &d)
 	{
-		return _fifo.pop(d);
+		if (_unbound) bind_local();
+
+		if (_ring) {
+			// Filters of the topic ring subscribers are evaluated here, keep_last
+			// history is filtered on push.
+			for (;;) {
+				size_t lag = 0;
+				bool r = _ring->load(_cursor, d, lag, *_head);
+				if (_hist)
+					_overwrite_count += lag;
+				else
+					_drop_count += lag;
+				if (!r || _hist || accept(d)) return r;
+			}
+		}
+
+		bool r;
+		if (_mpsc)
+			r = _mpsc->pop(d);
+		else if (_lanes)
+			r = pop_lanes(d);
+		else if (!_refs)
+			r = _fifo.pop(d);
+		else {
+			sample* s;
+			if (!_refs->pop(s)) return false;
+			d = s->d;
+			s->pool->put(s);
+			return true;
+		}
+
+		if (r && _room) room_freed();
+		return r;
+	}
+
+	/// Pop sample reference.
+	/// Lockfree and nonblocking.
+	/// @param[out] s sample pointer (reference is owned by the caller)
+	/// @return false if queue is empty, true otherwise
+	bool pop(sample* &s)
+	{
+		if (_unbound) bind_local();
+		return _refs && _refs->pop(s);
+	}
+
+	/// Consume queued data in place.
+	/// The callback gets a const reference to the queued data and must not throw.
+	/// Fifo slots are released in bulk. Ring subscribers get a validated copy of each entry.
+	/// Lanes are consumed one after another with a single read index update per lane,
+	/// per-publisher order is preserved but entries are not merged by seqno (@see pop).
+	/// @param[in] fn callback, void fn(const data&)
+	/// @param[in] max max number of entries to consume
+	/// @return number of consumed entries
+	template<typename F>
+	size_t drain(F&& fn, size_t max)
+	{
+		if (_unbound) bind_local();
+
+		if (_ring) {
+			data d;
+			size_t n = 0;
+			for (; n < max && pop(d); n++) fn(static_cast<const data&>(d));
+			return n;
+		}
+
+		if (_refs)
+			return _refs->consume([&](sample* s) { fn(static_cast<const data&>(s->d)); s->pool->put(s); }, max);
+
+		size_t n = 0;
+		if (_mpsc)
+			n = _mpsc->consume([&](const data& d) { fn(d); }, max);
+		else if (_lanes) {
+			// One bulk consume per lane, starting from the next round-robin lane
+			for (unsigned int k=0; k < _nlanes && n < max; k++) {
+				unsigned int i = _rr_lane + k;
+				if (i >= _nlanes) i -= _nlanes;
+
+				lane* l = _lanes[i].load(std::memory_order_acquire);
+				if (l) n += l->fifo.consume([&](const data& d) { fn(d); }, max - n);
+			}
+			if (++_rr_lane >= _nlanes) _rr_lane = 0;
+		} else
+			n = _fifo.consume([&](const data& d) { fn(d); }, max);
+
+		if (n && _room) room_freed();
+		return n;
 	}
 
 	/// Shutdown queue
 	void shutdown(std::chrono::nanoseconds t, bool need_lock = false)
 	{
-		if (_notifier)
-			_notifier->shutdown(t);
+		with_notifier([t](vdds::notifier* n) { n->shutdown(t); });
+	}
+
+private:
+	/// Call into the notifier.
+	/// Noop for the queues without notifier. Called by the publishers within the epoch
+	/// critical section, no shared writes (@see detach).
+	template<typename F>
+	void with_notifier(F&& fn)
+	{
+		vdds::notifier* n = _notifier.load(std::memory_order_acquire);
+		if (n) fn(n);
+	}
+
+	/// Bind the slots of the queue backend to the node (deferred placement)
+	template<typename Q>
+	static void bind(const Q& q, int node)
+	{
+		auto& a = q.get_allocator();
+		if (a.where.deferred && a.region) detail::bind(a.region, a.region_size, a.where, node);
+	}
+
+	/// Sum lane stats
+	template<typename F>
+	size_t lane_sum(F f) const
+	{
+		size_t n = 0;
+		for (unsigned int i=0; i < _nlanes; i++) {
+			const lane* l = _lanes[i].load(std::memory_order_acquire);
+			if (l) n += f(l);
+		}
+		return n;
+	}
+
+	/// Get the next lane to pop from.
+	/// Seqno order picks the lowest seqno among the lane heads. Data that is still
+	/// being pushed by a slower publisher may be popped after data with higher seqno.
+	/// @param[out] best lane pointer
+	/// @return pointer to the front element of the lane, or nullptr if all lanes are empty
+	data* lanes_front(lane* &best)
+	{
+		data* bd = nullptr;
+		best = nullptr;
+
+		for (unsigned int n=0; n < _nlanes; n++) {
+			unsigned int i = _rr_lane + n;
+			if (i >= _nlanes) i -= _nlanes;
+
+			lane* l = _lanes[i].load(std::memory_order_acquire);
+			if (!l) continue;
+
+			data* f = l->fifo.front();
+			if (!f) continue;
+
+			if (_order == sub_qos::lane_order::round_robin) {
+				best = l; bd = f;
+				_rr_lane = i + 1 < _nlanes ? i + 1 : 0;
+				break;
+			}
+
+			if (!bd || f->seqno < bd->seqno) { best = l; bd = f; }
+		}
+
+		return bd;
+	}
+
+	/// Pop data from the lanes.
+	bool pop_lanes(data &d)
+	{
+		lane* l;
+		data* f = lanes_front(l);
+		if (!f) return false;
+
+		d = *f;
+		l->fifo.pop();
+		return true;
 	}
 };
 
+using sub_queue = basic_sub_queue<data>;
+
 } // namespace vdds
 
 #endif // VDDS_SUB_QUEUE_HPP
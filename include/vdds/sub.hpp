@@ -39,12 +39,14 @@
 #include <mutex>
 #include <atomic>
 #include <stdexcept>
+#include <functional>
 
 #include <hogl/area.hpp>
 #include <hogl/post.hpp>
 
 #include "domain.hpp"
 #include "topic.hpp"
+#include "coro.hpp"
 
 namespace vdds {
 
@@ -54,9 +56,15 @@ namespace vdds {
 /// @param T data type
 template<typename T>
 class sub {
+public:
+	using data = typename T::slot_type; ///< data size class
+
 private:
-	vdds::sub_queue* _queue; ///< subscriber queue pointer
-	vdds::topic*     _topic; ///< topic pointer
+	vdds::basic_sub_queue<data>* _queue; ///< subscriber queue pointer
+	vdds::basic_topic<data>*     _topic; ///< topic pointer
+#ifdef VDDS_WITH_COROUTINES
+	coro::member*                _coro = nullptr; ///< coroutine scheduler member (null if not attached)
+#endif
 
 public:
 	/// Create subscriber.
@@ -66,23 +74,60 @@ public:
 	/// @param[in] topic_name topic name name 
 	/// @param[in] qsize size of the queue
 	/// @param[in] ntfr notifier pointer (null, cv, poll) 
+	/// @param[in] qos subscriber QoS
 	explicit sub(domain& vd, const std::string& name, const std::string& topic_name,
-			size_t qsize = 16, notifier* ntfr = nullptr)
+			size_t qsize = 16, notifier* ntfr = nullptr, const sub_qos& qos = sub_qos())
 	{
-		static_assert(sizeof(T) == sizeof(data), "data type size missmatch");
-
-		_topic = vd.create_topic(topic_name, T::data_type);
-		if (!_topic)
-			throw std::logic_error("failed to create topic");
+		init(vd, name, topic_name, qsize, ntfr, qos);
+	}
 
-		_queue = _topic->subscribe(name, qsize, ntfr);
+	/// Create content-filtered subscriber.
+	/// Same as above, data rejected by the filter is not queued (@see sub_qos::filter).
+	/// @param[in] vd reference to the domain
+	/// @param[in] name subscriber name
+	/// @param[in] topic_name topic name name
+	/// @param[in] filter filter predicate, bool fn(const T&)
+	/// @param[in] qsize size of the queue
+	/// @param[in] ntfr notifier pointer (null, cv, poll)
+	/// @param[in] qos subscriber QoS
+	explicit sub(domain& vd, const std::string& name, const std::string& topic_name,
+			std::function<bool(const T&)> filter,
+			size_t qsize = 16, notifier* ntfr = nullptr, sub_qos qos = sub_qos()) :
+		sub(vd, name, topic_name, qsize, ntfr, with_filter(qos, std::move(filter)))
+	{}
+
+#ifdef VDDS_WITH_COROUTINES
+	/// Create subscriber attached to a coroutine scheduler.
+	/// Same as above, the scheduler member is used as the notifier and the subscriber
+	/// can be awaited with co_await next().
+	/// @param[in] vd reference to the domain
+	/// @param[in] name subscriber name
+	/// @param[in] topic_name topic name name
+	/// @param[in] sched coroutine scheduler (throws if full)
+	/// @param[in] qsize size of the queue
+	/// @param[in] qos subscriber QoS
+	explicit sub(domain& vd, const std::string& name, const std::string& topic_name,
+			coro::scheduler& sched, size_t qsize = 16, const sub_qos& qos = sub_qos())
+	{
+		_coro = sched.add();
+		try {
+			init(vd, name, topic_name, qsize, _coro, qos);
+		} catch (...) {
+			sched.remove(_coro);
+			throw;
+		}
 	}
+#endif
 
 	/// Delete subscriber.
 	/// Unsubscribes from the topic. The queue is flushed and removed.
+	/// Coroutine scheduler member (if any) is returned to the scheduler.
 	~sub()
 	{
 		_topic->unsubscribe(_queue);
+#ifdef VDDS_WITH_COROUTINES
+		if (_coro) _coro->sched().remove(_coro);
+#endif
 	}
 
 	/// No copy
@@ -94,20 +139,87 @@ public:
 	const std::string& data_type() const { return _queue->data_type(); }
 
 	/// Get queue and topic pointers
-	vdds::sub_queue* queue() { return _queue; }
-	vdds::topic* topic() { return _topic; }
+	vdds::basic_sub_queue<data>* queue() { return _queue; }
+	vdds::basic_topic<data>* topic() { return _topic; }
+
+	/// Bind queue slots to the NUMA node of the calling thread (numa_policy::local).
+	/// Optional, the first pop binds the slots otherwise. Must be called from the consumer thread.
+	void bind_local() { _queue->bind_local(); }
 
 	/// Pop data from fifo
 	/// @param[out] d ref to data
 	/// @return false if queue is empty, true otherwise
 	bool pop(T& d) { return _topic->pop(_queue, static_cast<data&>(d)); }
 
+	/// Pop sample reference from fifo.
+	/// Zero-copy version of pop() for topics with sample pool.
+	/// @param[out] r ref to sample reference
+	/// @return false if queue is empty, true otherwise
+	bool pop(vdds::sample_ref<T>& r)
+	{
+		vdds::basic_sample<data>* s;
+		if (!_topic->pop(_queue, s)) return false;
+		r.reset(s);
+		return true;
+	}
+
+	/// Consume queued data in place.
+	/// Cheaper than pop() for bursts: the data is not copied out of the queue and
+	/// the queue slots are released in bulk.
+	/// The callback must not throw and must not keep references to the data.
+	/// @param[in] fn callback, void fn(const T&)
+	/// @param[in] max max number of entries to consume
+	/// @return number of consumed entries
+	template<typename F>
+	size_t drain(F&& fn, size_t max = SIZE_MAX)
+	{
+		return _topic->drain(_queue, [&](const data& d) { fn(static_cast<const T&>(d)); }, max);
+	}
+
 	/// Flush all queued data
 	void flush()
 	{
 		T d;
 		while (pop(d));
 	}
+
+#ifdef VDDS_WITH_COROUTINES
+	/// Awaitable pop.
+	/// co_await sub.next() suspends the coroutine until data arrives.
+	/// One awaiting coroutine per subscriber: co_await in a second coroutine while the first
+	/// one is suspended throws std::logic_error.
+	/// Throws std::logic_error if the subscriber was not created with a coroutine scheduler.
+	/// @return awaiter, co_await returns the data
+	coro::next_awaiter<T> next()
+	{
+		if (!_coro)
+			throw std::logic_error("subscriber " + name() + " is not attached to a coroutine scheduler");
+		return coro::next_awaiter<T>(*this, _coro);
+	}
+#endif
+
+private:
+	/// Create topic and subscribe (@see constructors)
+	void init(domain& vd, const std::string& name, const std::string& topic_name,
+			size_t qsize, notifier* ntfr, const sub_qos& qos)
+	{
+		static_assert(sizeof(T) == sizeof(data), "data type size missmatch");
+
+		_topic = vd.create_topic<data>(topic_name, T::data_type);
+		if (!_topic)
+			throw std::logic_error("failed to create topic");
+
+		_queue = _topic->subscribe(name, qsize, ntfr, qos);
+		if (!_queue)
+			throw std::logic_error("failed to subscribe");
+	}
+
+	/// Wrap typed filter into the QoS
+	static sub_qos& with_filter(sub_qos& qos, std::function<bool(const T&)> f)
+	{
+		if (f) qos.filter = [f](const plain_header& d) { return f(static_cast<const T&>(d)); };
+		return qos;
+	}
 };
 
 } // namespace vdds
@@ -35,93 +35,401 @@
 #include <string>
 #include <vector>
 #include <shared_mutex>
+#include <mutex>
 #include <atomic>
 #include <memory>
 #include <list>
+#include <algorithm>
+#include <chrono>
 
 #include <hogl/area.hpp>
 #include <hogl/post.hpp>
 
+#include "detail/epoch.hpp"
 #include "sub-queue.hpp"
 #include "pub-handle.hpp"
+#include "sample.hpp"
 #include "query.hpp"
+#include "qos.hpp"
 
 namespace vdds {
 
-/// VDDS topic.
-/// Contains subscriber queues and publisher handles.
-class topic {
-private:
+/// Topic base.
+/// Size class independent part of the topic, used by the domain for lookup, dump, query, etc.
+class topic_base {
+protected:
 	std::string _domain;    ///> domain name
 	std::string _name;      ///> topic name
 	std::string _data_type; ///> data type name
+	topic_qos   _qos;       ///> topic QoS
+	size_t      _slot_size; ///> data size class (bytes)
+	bool        _plain;     ///> plain-only data (no shared payload)
 
 	hogl::area* _area; ///> log area
 
+	/// Create topic base
+	/// @param[in] domain domain name
+	/// @param[in] name topic name
+	/// @param[in] data_type data type name
+	/// @param[in] qos topic QoS
+	/// @param[in] slot_size data size class
+	/// @param[in] plain plain-only data
+	topic_base(const std::string& domain, const std::string& name, const std::string& data_type,
+			const topic_qos& qos, size_t slot_size, bool plain);
+
+public:
+	virtual ~topic_base() { }
+
+	// No copies
+	topic_base( const topic_base& ) = delete;
+	topic_base& operator=( const topic_base& ) = delete;
+
+	// Get topic name and data type
+	const std::string& domain() const { return _domain; }
+	const std::string& name() const { return _name; }
+	const std::string& data_type() const { return _data_type; }
+
+	/// Get data size class (size of the data in bytes)
+	size_t slot_size() const { return _slot_size; }
+
+	/// Check if the topic carries plain-only data
+	bool plain_only() const { return _plain; }
+
+	/// Get topic QoS
+	const topic_qos& qos() const { return _qos; }
+
+	/// Dump topic state (pubs, subs, etc) to debug log.
+	virtual void dump() = 0;
+
+	/// Query topic info & stats.
+	/// To avoid runtime overhead the caller should preallocate query info (@see vdds::query::init)
+	/// @param[out] i topic info
+	virtual void query(query::topic_info& i) = 0;
+
+	/// Kick (wakeup) all subscribers.
+	virtual void kick() = 0;
+
+	/// Shutdown topic
+	/// Wakeup all subscribers, and override timeouts on notifiers
+	/// @param[in] t new timeout for notifiers
+	virtual void shutdown(std::chrono::nanoseconds t) = 0;
+};
+
+/// VDDS topic.
+/// Contains subscriber queues and publisher handles.
+/// @param D data size class
+template<typename D>
+class basic_topic final : public topic_base {
+public:
+	using data        = D;
+	using sample      = basic_sample<D>;
+	using sample_pool = basic_sample_pool<D>;
+	using sub_queue   = basic_sub_queue<D>;
+
+private:
+	std::unique_ptr<sample_pool> _pool; ///> sample pool (null if disabled)
+	std::unique_ptr<detail::bcast_ring<data>> _ring; ///> broadcast ring (null if disabled)
+
+	// Durability state (topics without ring, ring subscribers start behind the head instead)
+	std::vector<data> _durable;       ///> last published samples (empty if volatile)
+	uint64_t          _durable_count; ///> number of samples stored in the history
+	std::mutex        _durable_mutex; ///> protects the history, orders history appends with subscribe
+
 	struct cache {
 		std::vector<sub_queue*>  subs; ///> list of subscribers queues (vect)
 		std::vector<pub_handle*> pubs; ///> list of publisher handles (vect)
+
+		/// References: the cache pointer (or the retired list), and the publishers
+		/// blocked outside of the epoch critical section (@see reliable_op)
+		mutable std::atomic<uint32_t> refs;
+
+		cache() : refs(1) {}
+
+		/// Copies reference the listed queues
+		cache(const cache& c) : subs(c.subs), pubs(c.pubs), refs(1)
+		{
+			for (auto &q : subs) q->get();
+		}
+
+		~cache()
+		{
+			for (auto &q : subs) q->put();
+		}
+
+		/// Drop reference, deletes the cache when the last reference is dropped
+		static void release(const cache* c)
+		{
+			if (c->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete c;
+		}
 	};
 
 	std::atomic<uint64_t> _next_seqno; ///> seqno for next pub operation
+	std::atomic<uint32_t> _lockless_waiters; ///> single-publisher pushes blocked outside of the epoch (@see publish)
 
 	// Cache related state
 	std::atomic<cache*>   _cache_ptr;    ///> cache pointer
-	std::atomic<uint32_t> _cache_refcnt; ///> cache ref count
 	std::shared_timed_mutex _mutex;  ///> shared_mutex protects cache reads & updates
 
-	/// Grab cache reference
+	/// Grab cache reference.
+	/// Enters epoch critical section, no shared writes.
 	const cache* cache_get()
 	{
-		_cache_refcnt.fetch_add(1, std::memory_order_acquire);
-		return _cache_ptr.load();
+		detail::epoch::enter();
+		return _cache_ptr.load(std::memory_order_acquire);
 	}
 
 	/// Release cache reference
 	void cache_put(const cache* c)
 	{
-		_cache_refcnt.fetch_sub(1, std::memory_order_release);
+		detail::epoch::exit();
 	}
 
+	/// Reliable publish op.
+	/// Publishers blocked on a reliable queue leave the epoch critical section, so that a slow
+	/// subscriber does not hold up the reclamation. The cache, and the queues it lists, is
+	/// pinned with a reference instead.
+	struct reliable_op : push_op {
+		basic_topic* t;  ///> topic
+		const cache* c;  ///> cache used by the op
+		bool nl;         ///> lock flag of the op
+		bool pinned;     ///> cache is pinned
+
+		reliable_op(basic_topic* tp, const cache* cp, bool l) : t(tp), c(cp), nl(l), pinned(false) {}
+
+		void suspend() override
+		{
+			if (!pinned) {
+				c->refs.fetch_add(1, std::memory_order_relaxed);
+				if (!nl) t->_lockless_waiters.fetch_add(1, std::memory_order_seq_cst);
+				pinned = true;
+			}
+			detail::epoch::exit();
+		}
+
+		void resume() override { detail::epoch::enter(); }
+
+		/// Release cache reference, and the pin (if any)
+		void put()
+		{
+			t->cache_put(c);
+			if (!pinned) return;
+			if (!nl) t->_lockless_waiters.fetch_sub(1, std::memory_order_release);
+			cache::release(c);
+		}
+	};
+
 	/// Get a copy of the cache.
 	/// Allocates new instance and copies the content.
 	cache* cache_copy();
 
-	/// Atomically swap cache pointer and release the orignal
+	/// Atomically swap cache pointer and retire the orignal.
+	/// The original cache is freed lazily once all readers are done with it.
 	void cache_swap(cache *n);
 
 	// Lock is needed only if this topic has multiple publishers
 	bool need_lock(const cache* c) const { return c->pubs.size() > 1; }
 
+	/// Lock durable history. Noop for volatile topics.
+	std::unique_lock<std::mutex> durable_lock()
+	{
+		return _durable.empty() ? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(_durable_mutex);
+	}
+
+	/// Store sample in the durable history.
+	/// Caller must hold the durable lock.
+	void keep(const data& d)
+	{
+		_durable[_durable_count++ % _durable.size()] = d;
+	}
+
+	/// Assign seqnos, store the data in the durable history and grab cache reference.
+	/// On durable topics the seqno range and the cache reference are taken under the durable lock,
+	/// which splits the stream for the new subscribers at a seqno: entries kept before the queue
+	/// was registered are preloaded (@see subscribe), the rest is pushed by the publishers.
+	/// The lock is not held across the fan-out.
+	/// @param[in] d pointer to the first entry
+	/// @param[in] n number of entries
+	/// @return cache pointer (release with cache_put)
+	const cache* stamp(data* d, size_t n)
+	{
+		auto dl = durable_lock();
+
+		uint64_t seqno = _next_seqno.fetch_add(n, std::memory_order_relaxed);
+		for (size_t i = 0; i < n; i++) d[i].seqno = seqno + i;
+		for (size_t i = 0; !_durable.empty() && i < n; i++) keep(d[i]);
+
+		return cache_get();
+	}
+
+	/// Get shared payload handle (null for plain-only data)
+	static const shared_handle* shared_of(const data_header& d) { return &d.shared; }
+	static const shared_handle* shared_of(const plain_header& d) { return nullptr; }
+
+	/// Preload durable history into the new subscriber queue.
+	/// Caller must hold the durable lock.
+	void preload(sub_queue* q);
+
+	/// Push sample reference to all subscribers.
+	/// Takes over the caller's reference, the sample must not be accessed after this call.
+	/// @return seqno assigned to the sample
+	uint64_t fanout(pub_handle* ph, sample* s)
+	{
+		data& d = s->d;
+
+		// Grab cache reference
+		auto *c = stamp(&d, 1);
+		uint64_t seqno = d.seqno;
+
+		hogl::post(_area, _area->TRACE, hogl::arg_gstr(ph->trace_fmt()),
+				d.seqno, d.timestamp, c->subs.size(), c->pubs.size());
+
+		bool nl = need_lock(c);
+
+		// Caller owns the only reference at this point.
+		// One reference per subscriber is added upfront, queues that did not take
+		// their reference (full) are accounted for below.
+		s->refcnt.store(c->subs.size() + 1, std::memory_order_relaxed);
+
+		uint32_t nput = 1; // caller's reference
+		for (auto &q : c->subs) { if (!q->accept(s->d) || !q->push(s, nl)) nput++; }
+
+		// Release cache reference
+		cache_put(c);
+
+		_pool->put(s, nput);
+		return seqno;
+	}
+
+	/// Push batch of data to all subscribers via pooled samples.
+	/// Samples are delivered in chunks. Filtering subscriber queues are kicked once per chunk
+	/// with accepted samples, the rest is kicked by the caller.
+	/// @param[in] c cache pointer
+	/// @param[in] d pointer to the first entry
+	/// @param[in] n number of entries
+	void fanout(const cache* c, const data* d, size_t n)
+	{
+		static const size_t chunk = 64;
+
+		bool nl = need_lock(c);
+		uint32_t nsubs = c->subs.size();
+
+		for (size_t off = 0; off < n; off += chunk) {
+			size_t k = std::min(chunk, n - off);
+
+			sample*  s[chunk];
+			uint32_t nput[chunk];
+
+			// Grab samples and references, stops when the pool is exhausted
+			size_t ns = 0;
+			for (; ns < k; ns++) {
+				s[ns] = _pool->get();
+				if (!s[ns]) break;
+				s[ns]->d = d[off + ns];
+				s[ns]->refcnt.store(nsubs + 1, std::memory_order_relaxed);
+				nput[ns] = 1; // caller's reference
+			}
+
+			for (auto &q : c->subs) {
+				if (!q->has_filters()) {
+					size_t r = q->push(s, ns, nl);
+					for (size_t j = r; j < ns; j++) nput[j]++;
+					if (ns < k) q->drop(nl, k - ns);
+					continue;
+				}
+
+				// Accepted samples only, references of the rest are returned below
+				sample*  as[chunk];
+				uint32_t ai[chunk];
+				size_t na = 0, nd = 0;
+				for (size_t j = 0; j < ns; j++) {
+					if (q->accept(s[j]->d)) { as[na] = s[j]; ai[na++] = j; }
+					else nput[j]++;
+				}
+				for (size_t j = ns; j < k; j++) nd += q->accept(d[off + j]);
+
+				size_t r = q->push(as, na, nl);
+				for (size_t j = r; j < na; j++) nput[ai[j]]++;
+				if (nd) q->drop(nl, nd);
+				if (na) q->kick(nl);
+			}
+
+			for (size_t j = 0; j < ns; j++) _pool->put(s[j], nput[j]);
+		}
+	}
+
+	/// Push accepted entries of the batch into the filtering queue.
+	/// Runs of accepted entries are pushed in bulk, the queue is not kicked.
+	/// @param[in] q subscriber queue
+	/// @param[in] d pointer to the first entry
+	/// @param[in] n number of entries
+	/// @param[in] li publisher lane index
+	/// @param[in] nl lock flag
+	/// @param[in,out] op publish op (reliable deadline)
+	/// @param[out] na number of accepted entries
+	/// @return number of entries pushed
+	size_t push_filtered(sub_queue* q, const data* d, size_t n, unsigned int li, bool nl, push_op* op, size_t& na)
+	{
+		size_t r = 0;
+		na = 0;
+		for (size_t i = 0; i < n; i++) {
+			if (!q->accept(d[i])) continue;
+
+			// Extend the run, the entry that ends it (if any) is already rejected
+			size_t j = i + 1;
+			while (j < n && q->accept(d[j])) j++;
+
+			na += j - i;
+			r  += q->push(d + i, j - i, li, nl, op);
+			i = j;
+		}
+		return r;
+	}
+
+	/// Drop data.
+	/// Used when the sample pool is exhausted. Data is accounted as dropped by all subscribers.
+	/// @param[in] ph publisher handle
+	/// @param[in] d data reference
+	void drop(pub_handle* ph, data& d)
+	{
+		auto *c = stamp(&d, 1);
+
+		hogl::post(_area, _area->TRACE, hogl::arg_gstr(ph->trace_fmt()),
+				d.seqno, d.timestamp, c->subs.size(), c->pubs.size());
+
+		bool nl = need_lock(c);
+		for (auto &q : c->subs) { if (q->accept(d)) q->drop(nl); }
+
+		cache_put(c);
+	}
+
 public:
 	/// Create topic
 	/// @param[in] domain domain name
 	/// @param[in] name topic name
 	/// @param[in] data_type data type name
-	explicit topic(const std::string& domain, const std::string& name, const std::string& data_type);
+	/// @param[in] qos topic QoS
+	explicit basic_topic(const std::string& domain, const std::string& name, const std::string& data_type,
+			const topic_qos& qos = topic_qos());
 
 	/// Delete topic
-	~topic();
-
-	// No copies
-	topic( const topic& ) = delete;
-	topic& operator=( const topic& ) = delete;
-
-	// Get topic name and data type
-	const std::string& domain() const { return _domain; }
-	const std::string& name() const { return _name; }
-	const std::string& data_type() const { return _data_type; }
+	~basic_topic();
 
 	/// Subscribe to this topic.
 	/// Creates subscriber queue.
 	/// @param[in] name subscriber name
 	/// @param[in] qsize size of the queue (num data elemenents)
 	/// @param[in] ntfr notifier (null, cv, polling)
+	/// @param[in] qos subscriber QoS
 	/// @return pointer to the subscriber queue
-	sub_queue* subscribe(const std::string& name, unsigned int qsize = 16, notifier* ntfr = nullptr);
+	sub_queue* subscribe(const std::string& name, unsigned int qsize = 16, notifier* ntfr = nullptr,
+			const sub_qos& qos = sub_qos());
 
 	/// Unsubscribe from this topic.
-	/// @param[in] q subscriber queue
+	/// Waits for the epoch grace period (not for the publishers blocked on reliable queues),
+	/// the notifier is no longer used when this call returns. The queue is deleted once the
+	/// publishers in flight are done with it.
+	/// @param[in] q subscriber queue (must not be used after this call)
 	void unsubscribe(sub_queue *q);
 
 	/// Publish this topic.
@@ -133,35 +441,156 @@ public:
 	/// @param[in] publisher handle.
 	void unpublish(pub_handle* p);
 
-	/// Dump topic state (pubs, subs, etc) to debug log.
-	void dump();
+	void dump() override;
+	void query(query::topic_info& i) override;
 
-	/// Query topic info & stats.
-	/// To avoid runtime overhead the caller should preallocate query info (@see vdds::query::init)
-	/// @param[out] i topic info
-	void query(query::topic_info& i);
+	/// Loan a sample from the topic pool.
+	/// The sample is filled in place by the publisher and then published with commit().
+	/// Lockfree and nonblocking.
+	/// @return sample pointer, or nullptr if the pool is disabled or exhausted
+	sample* loan()
+	{
+		return _pool ? _pool->get() : nullptr;
+	}
+
+	/// Publish loaned sample.
+	/// Subscribers receive a reference to the sample, the data is not copied.
+	/// Takes over the caller's reference.
+	/// @param[in] ph publisher handle
+	/// @param[in] s sample pointer (@see loan())
+	void commit(pub_handle* ph, sample* s)
+	{
+		fanout(ph, s);
+	}
 
 	/// Push data to all subscribers.
 	/// This method pushes a copy of data into each subscriber queue.
+	/// Topics with sample pool copy the data once into a pooled sample.
+	/// Topics with broadcast ring store a single copy in the ring and wake up subscribers.
+	/// Durable topics also store a copy in the history.
+	/// Reliable subscribers may block the caller up to their max blocking time.
+	/// Data rejected by the subscriber filters is not pushed and does not wake up the subscriber.
 	/// @param[in] ph publisher handle
 	/// @param[in] d data reference
-	void push(pub_handle* ph, data& d)
+	/// @param[out] timed_out optional list of the reliable subscriber queues that timed out
+	/// @return number of the reliable subscribers that timed out (the data was dropped)
+	size_t push(pub_handle* ph, data& d, std::vector<const sub_queue*>* timed_out = nullptr)
 	{
-		d.seqno = _next_seqno.fetch_add(1, std::memory_order_relaxed);
+		if (_ring) {
+			auto *c = stamp(&d, 1);
+
+			hogl::post(_area, _area->TRACE, hogl::arg_gstr(ph->trace_fmt()),
+					d.seqno, d.timestamp, c->subs.size(), c->pubs.size());
+
+			// Ring slots are claimed by seqno, no locking required for multiple publishers
+			_ring->store(d.seqno, d);
+			for (auto &q : c->subs) { q->kick(); }
+
+			cache_put(c);
+			return 0;
+		}
+
+		if (_pool) {
+			sample* s = _pool->get();
+			if (!s) {
+				drop(ph, d);
+				return 0;
+			}
+
+			s->d = d;
+			d.seqno = fanout(ph, s);
+			return 0;
+		}
 
 		// Grab cache reference
-		auto *c = cache_get();
+		auto *c = stamp(&d, 1);
 
 		hogl::post(_area, _area->TRACE, hogl::arg_gstr(ph->trace_fmt()),
 				d.seqno, d.timestamp, c->subs.size(), c->pubs.size());
 
 		bool nl = need_lock(c);
 
-		// Push into each queue, creates proper copy of shared data (if any)
-		for (auto &q : c->subs) { q->push(d, nl); }
+		// Push into each queue, the queued copies take over the shared payload references.
+		// References to the intrusive payload are added for all queues upfront, the ones
+		// that were not taken over (filtered, dropped) are dropped at once below.
+		auto sh = shared_of(d);
+		if (sh) sh->add_ref(c->subs.size());
+
+		// Reliable queues share the deadline, the publisher is blocked up to max blocking time in total
+		reliable_op op(this, c, nl);
+
+		size_t nto = 0;
+		uint32_t unused = 0;
+		for (auto &q : c->subs) {
+			if (!q->accept(d)) { unused++; continue; }
+
+			if (!q->push(d, adopt_ref, ph->lane(), nl, &op)) {
+				unused++;
+				if (!q->reliable()) continue;
+				nto++;
+				if (timed_out) timed_out->push_back(q);
+			}
+		}
+
+		if (sh) sh->drop_ref(unused);
 
 		// Release cache reference
-		cache_put(c);
+		op.put();
+		return nto;
+	}
+
+	/// Push batch of data to all subscribers.
+	/// Same as push() for each entry, except that the seqno range, the cache reference and
+	/// the trace record are taken once for the whole batch, the data is inserted into
+	/// the subscriber queues in bulk, and each subscriber is notified once.
+	/// @param[in] ph publisher handle
+	/// @param[in] d pointer to the first entry
+	/// @param[in] n number of entries
+	/// @param[out] timed_out optional list of the reliable subscriber queues that timed out
+	/// @return number of the reliable subscribers that timed out (some of the data was dropped)
+	size_t push_batch(pub_handle* ph, data* d, size_t n, std::vector<const sub_queue*>* timed_out = nullptr)
+	{
+		if (!n) return 0;
+
+		// Grab cache reference
+		auto *c = stamp(d, n);
+		uint64_t seqno = d[0].seqno;
+
+		hogl::post(_area, _area->TRACE, hogl::arg_gstr(ph->batch_trace_fmt()),
+				seqno, d[0].timestamp, n, c->subs.size(), c->pubs.size());
+
+		bool nl = need_lock(c);
+		size_t nto = 0;
+
+		// Reliable queues and runs share the deadline (@see push)
+		reliable_op op(this, c, nl);
+
+		if (_ring) {
+			for (size_t i = 0; i < n; i++) _ring->store(d[i].seqno, d[i]);
+			for (auto &q : c->subs) { q->kick(nl); }
+		} else if (_pool) {
+			fanout(c, d, n);
+			for (auto &q : c->subs) { if (!q->has_filters()) q->kick(nl); }
+		} else {
+			for (auto &q : c->subs) {
+				size_t na, r;
+				if (!q->has_filters()) {
+					na = n;
+					r  = q->push(d, n, ph->lane(), nl, &op);
+				} else
+					r  = push_filtered(q, d, n, ph->lane(), nl, &op, na);
+
+				if (r != na && q->reliable()) {
+					nto++;
+					if (timed_out) timed_out->push_back(q);
+				}
+				if (na) q->kick(nl);
+			}
+		}
+
+		// Release cache reference
+		op.put();
+		return nto;
 	}
 
 	/// Pop data for subscriber.
@@ -176,18 +605,47 @@ public:
 		return true;
 	}
 
-	/// Kick (wakeup) all subscribers.
-	void kick()
+	/// Pop sample reference for subscriber.
+	/// Used with topics that have sample pool.
+	/// @param[in] sq subscriber queue
+	/// @param[out] s sample pointer (reference is owned by the caller)
+	bool pop(sub_queue* sq, sample* &s)
+	{
+		if (!sq->pop(s)) return false;
+
+		hogl::post(_area, _area->TRACE, hogl::arg_gstr(sq->trace_fmt()), s->d.seqno, s->d.timestamp);
+		return true;
+	}
+
+	/// Consume queued data in place.
+	/// Posts one trace record per call (seqno and timestamp of the first entry).
+	/// @param[in] sq subscriber queue
+	/// @param[in] fn callback, void fn(const data&)
+	/// @param[in] max max number of entries to consume
+	/// @return number of consumed entries
+	template<typename F>
+	size_t drain(sub_queue* sq, F&& fn, size_t max)
+	{
+		uint64_t seqno = 0, timestamp = 0;
+		bool first = true;
+		size_t n = sq->drain([&](const data& d) {
+				if (first) { seqno = d.seqno; timestamp = d.timestamp; first = false; }
+				fn(d);
+			}, max);
+		if (!n) return 0;
+
+		hogl::post(_area, _area->TRACE, hogl::arg_gstr(sq->drain_trace_fmt()), seqno, timestamp, n);
+		return n;
+	}
+
+	void kick() override
 	{
 		auto *c = cache_get();
 		for (auto &q : c->subs) { q->kick(need_lock(c)); }
 		cache_put(c);
 	}
 
-	/// Shutdown topic
-	/// Wakeup all subscribers, and override timeouts on notifiers
-	/// @param[in] t new timeout for notifiers
-	void shutdown(std::chrono::nanoseconds t)
+	void shutdown(std::chrono::nanoseconds t) override
 	{
 		auto *c = cache_get();
 		for (auto &q : c->subs) { q->shutdown(t, need_lock(c)); }
@@ -195,6 +653,8 @@ public:
 	}
 };
 
+using topic = basic_topic<data>;
+
 } // namespace vdds
 
 #endif // VDDS_TOPIC_HPP
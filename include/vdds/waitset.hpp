@@ -0,0 +1,147 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef VDDS_WAITSET_HPP
+#define VDDS_WAITSET_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <chrono>
+
+#include "notifier.hpp"
+
+namespace vdds {
+
+/// Waitset.
+/// Blocks on many subscriber queues and returns exactly the ready ones.
+/// Each subscriber queue gets its own member notifier (@see add()). Pushes set the ready bit
+/// of the member in a lock-free bitmap, and only the first push after the bit was cleared
+/// wakes up the waiting thread. Ready bits are edge-triggered: wait() clears them, so the
+/// ready queues have to be drained (or re-armed with mark()).
+/// Meant for a single waiting thread.
+class waitset {
+public:
+	/// Waitset member.
+	/// Notifier for one subscriber queue.
+	class member : public notifier {
+	private:
+		waitset&     _ws; ///> owner waitset
+		unsigned int _id; ///> member id (ready bit)
+
+	public:
+		member(waitset& ws, unsigned int id) : notifier("waitset"), _ws(ws), _id(id) {}
+
+		/// Get member id
+		unsigned int id() const { return _id; }
+
+		/// Wait for any member of the waitset
+		void wait_for(std::chrono::nanoseconds t) override { _ws._nf.wait_for(t); }
+
+		/// Mark the member ready and wake up the waiter.
+		/// Called from queue::push.
+		void notify() override { _ws.mark(_id); }
+
+		/// Mark the member ready and set new timeout.
+		/// Called from queue::shutdown.
+		void shutdown(std::chrono::nanoseconds t) override
+		{
+			_ws.set(_id);
+			_ws._nf.shutdown(t);
+		}
+	};
+
+private:
+	std::vector<std::unique_ptr<member>>     _members; ///> member notifiers
+	std::unique_ptr<std::atomic<uint64_t>[]> _ready;   ///> ready bitmap
+	unsigned int   _capacity; ///> max number of members
+	notifier_futex _nf;       ///> notifier for the waiting thread
+
+	/// Set the ready bit.
+	/// Skips the RMW if the bit is already set (keeps the word shared between the notifiers
+	/// of a busy waitset). The fence orders the caller's data before the check, pairs with
+	/// the fence in collect(), so the waiter either sees the data or the notifier sets the bit.
+	/// @return true if the bit was clear
+	bool set(unsigned int id)
+	{
+		uint64_t m = uint64_t(1) << (id % 64);
+		auto& w = _ready[id / 64];
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (w.load(std::memory_order_relaxed) & m)
+			return false;
+
+		return !(w.fetch_or(m, std::memory_order_release) & m);
+	}
+
+	/// Collect and clear the ready bits
+	size_t collect(std::vector<unsigned int>& ready);
+
+public:
+	/// Create waitset.
+	/// @param capacity max number of members
+	explicit waitset(unsigned int capacity = 64);
+
+	// No copies
+	waitset(const waitset&) = delete;
+	waitset& operator=(const waitset&) = delete;
+
+	/// Add member.
+	/// Member ids are assigned in order starting from zero.
+	/// Must not be called concurrently with wait().
+	/// @return member notifier to be passed to the subscriber (null if the waitset is full)
+	member* add();
+
+	/// Get number of members
+	size_t size() const { return _members.size(); }
+
+	/// Get max number of members
+	size_t capacity() const { return _capacity; }
+
+	/// Mark the member ready and wake up the waiter.
+	/// Lockfree. Wakes up the waiter only if the member was not ready already.
+	/// @param id member id
+	void mark(unsigned int id)
+	{
+		if (set(id)) _nf.notify();
+	}
+
+	/// Wait for ready members.
+	/// May return with no ready members on timeout or shutdown.
+	/// @param[out] ready ids of the ready members (cleared first)
+	/// @param[in] t timeout (chrono duration)
+	/// @return number of ready members
+	size_t wait(std::vector<unsigned int>& ready, std::chrono::nanoseconds t = std::chrono::milliseconds(1));
+};
+
+} // namespace vdds
+
+#endif // VDDS_WAITSET_HPP
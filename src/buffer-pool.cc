@@ -0,0 +1,283 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <new>
+
+#include <hogl/area.hpp>
+#include <hogl/post.hpp>
+#include <hogl/fmt/format.h>
+
+#include "vdds/buffer-pool.hpp"
+#include "vdds/domain.hpp"
+
+namespace vdds {
+
+// Ids of the live pools.
+// Thread exit flushes the thread caches only into the pools that still exist.
+static std::mutex& registry_mutex()
+{
+	static std::mutex* m = new std::mutex(); // leaked, used by thread exit after static destructors
+	return *m;
+}
+
+static std::vector<uint64_t>& registry()
+{
+	static std::vector<uint64_t>* r = new std::vector<uint64_t>();
+	return *r;
+}
+
+static bool registered(uint64_t id)
+{
+	auto& r = registry();
+	return std::find(r.begin(), r.end(), id) != r.end();
+}
+
+static std::atomic<uint64_t> next_pool_id(1);
+
+// Thread caches of the calling thread
+struct pool_tls {
+	struct entry {
+		uint64_t id;                        ///> pool id
+		buffer_pool* pool;                  ///> pool pointer (valid only while the id is registered)
+		buffer_pool::thread_cache* cache;   ///> thread cache
+	};
+
+	std::vector<entry> entries;
+
+	~pool_tls();
+};
+
+static thread_local pool_tls tls;
+static thread_local bool tls_dead = false; // set once the caches are released (thread exit)
+
+pool_tls::~pool_tls()
+{
+	tls_dead = true;
+
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	for (auto &e : entries) {
+		if (registered(e.id)) e.pool->detach(e.cache);
+	}
+}
+
+buffer_pool::buffer_pool(domain& vd, const std::string& name, size_t count, size_t size, bool hugepages) :
+	_domain(vd), _name(name), _count(count), _size(size),
+	_stride((size + 63) & ~size_t(63)),
+	_id(next_pool_id.fetch_add(1, std::memory_order_relaxed)),
+	_mem(nullptr), _huge(false),
+	_free(count),
+	_cache_size(std::min<size_t>(32, count / 16)),
+	_caches(nullptr), _exhausted(0), _misses(0)
+{
+	if (!count || count >= UINT32_MAX || !size)
+		throw std::invalid_argument("invalid buffer pool size");
+
+	_area = hogl::add_area(fmt::format("VDDS{}{}", vd.name().empty() ? "" : "-", vd.name()).c_str());
+	if (!_area)
+		throw std::logic_error("failed to create log area");
+
+	_placement.hugepages = hugepages;
+	_mem = detail::map(_stride * count, _placement, &_huge);
+	if (!_mem)
+		throw std::bad_alloc();
+
+	_bufs.reset(new buffer[count]);
+
+	// Push in reverse order so that the first get() returns the first buffer
+	for (size_t i = count; i > 0; i--) {
+		buffer& b = _bufs[i - 1];
+		b.data = static_cast<uint8_t*>(_mem) + _stride * (i - 1);
+		b.size = size;
+		b.pool = this;
+		b.id   = i - 1;
+		_free.push(static_cast<uint32_t>(i - 1));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(registry_mutex());
+		registry().push_back(_id);
+	}
+
+	_domain.add_pool(this);
+
+	hogl::post(_area, _area->INFO, hogl::arg_gstr("new-pool %s count %u size %u hugepages %u (requested %u)"),
+			_name, _count, _size, _huge, hugepages);
+}
+
+buffer_pool::~buffer_pool()
+{
+	_domain.remove_pool(this);
+
+	{
+		// Exiting threads no longer flush their caches into this pool
+		std::lock_guard<std::mutex> lock(registry_mutex());
+		auto& r = registry();
+		r.erase(std::remove(r.begin(), r.end(), _id), r.end());
+	}
+
+	thread_cache* tc = _caches.load(std::memory_order_acquire);
+	while (tc) {
+		thread_cache* next = tc->next;
+		delete tc;
+		tc = next;
+	}
+
+	detail::unmap(_mem, _stride * _count, _placement);
+}
+
+buffer_pool::thread_cache* buffer_pool::local(bool create)
+{
+	if (!_cache_size || tls_dead) return nullptr;
+
+	for (auto &e : tls.entries) {
+		if (e.id == _id) return e.cache;
+	}
+
+	if (!create) return nullptr;
+
+	// Drop the caches of the deleted pools
+	{
+		std::lock_guard<std::mutex> lock(registry_mutex());
+		auto& v = tls.entries;
+		v.erase(std::remove_if(v.begin(), v.end(), [](const pool_tls::entry& e) { return !registered(e.id); }), v.end());
+	}
+
+	// Reuse a cache released by an exited thread
+	thread_cache* tc = _caches.load(std::memory_order_acquire);
+	for (; tc; tc = tc->next) {
+		bool f = false;
+		if (tc->in_use.compare_exchange_strong(f, true, std::memory_order_acquire))
+			break;
+	}
+
+	if (!tc) {
+		tc = new thread_cache();
+		tc->in_use.store(true, std::memory_order_relaxed);
+		tc->count = 0;
+		tc->ids.reset(new uint32_t[_cache_size]);
+		tc->hits.store(0, std::memory_order_relaxed);
+		tc->misses.store(0, std::memory_order_relaxed);
+
+		tc->next = _caches.load(std::memory_order_relaxed);
+		while (!_caches.compare_exchange_weak(tc->next, tc, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	tls.entries.push_back({ _id, this, tc });
+	return tc;
+}
+
+void buffer_pool::detach(thread_cache* tc)
+{
+	for (uint32_t i = 0; i < tc->count; i++) _free.push(tc->ids[i]);
+	tc->count = 0;
+	tc->in_use.store(false, std::memory_order_release);
+}
+
+shared_handle buffer_pool::get()
+{
+	uint32_t i;
+	thread_cache* tc = local(true);
+
+	if (tc && tc->count) {
+		i = tc->ids[--tc->count];
+		tc->hits.store(tc->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return shared_handle(&_bufs[i]);
+	}
+
+	if (!_free.pop(i)) {
+		_exhausted.fetch_add(1, std::memory_order_relaxed);
+		return shared_handle();
+	}
+
+	if (!tc) {
+		_misses.fetch_add(1, std::memory_order_relaxed);
+		return shared_handle(&_bufs[i]);
+	}
+
+	tc->misses.store(tc->misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// Refill half of the cache, so that the next gets are served locally
+	uint32_t n;
+	while (tc->count < _cache_size / 2 && _free.pop(n)) tc->ids[tc->count++] = n;
+
+	return shared_handle(&_bufs[i]);
+}
+
+void buffer_pool::put(buffer* b) noexcept
+{
+	// Release-only threads (typically subscribers) don't get a cache, otherwise
+	// the buffers would be stuck in there while the publisher runs out.
+	thread_cache* tc = local(false);
+	if (!tc) {
+		_free.push(b->id);
+		return;
+	}
+
+	// Cache is full, move the older half to the global list
+	if (tc->count == _cache_size) {
+		uint32_t h = _cache_size / 2;
+		for (uint32_t i = 0; i < h; i++) _free.push(tc->ids[i]);
+		std::copy(&tc->ids[h], &tc->ids[tc->count], &tc->ids[0]);
+		tc->count -= h;
+	}
+
+	tc->ids[tc->count++] = b->id;
+}
+
+void buffer_pool::query(query::pool_info& pi)
+{
+	pi.name = _name;
+	pi.count = _count;
+	pi.buffer_size = _size;
+	pi.hugepages = _huge;
+	pi.hit_count = 0;
+	pi.miss_count = _misses.load(std::memory_order_relaxed);
+	pi.exhausted_count = _exhausted.load(std::memory_order_relaxed);
+
+	for (auto tc = _caches.load(std::memory_order_acquire); tc; tc = tc->next) {
+		pi.hit_count  += tc->hits.load(std::memory_order_relaxed);
+		pi.miss_count += tc->misses.load(std::memory_order_relaxed);
+	}
+}
+
+void buffer_pool::dump()
+{
+	query::pool_info pi;
+	query(pi);
+
+	hogl::post(_area, _area->INFO, hogl::arg_gstr("pool %s count %u size %u hugepages %u hits %llu misses %llu exhausted %llu"),
+			pi.name, pi.count, pi.buffer_size, pi.hugepages, pi.hit_count, pi.miss_count, pi.exhausted_count);
+}
+
+} // namespace vdds
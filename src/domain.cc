@@ -29,12 +29,14 @@
 //  SPDX-License-Identifier: BSD-3-Clause
 
 #include <stdexcept>
+#include <algorithm>
 
 #include <hogl/area.hpp>
 #include <hogl/post.hpp>
 #include <hogl/fmt/format.h>
 
 #include "vdds/domain.hpp"
+#include "vdds/buffer-pool.hpp"
 
 namespace vdds {
 
@@ -45,36 +47,66 @@ domain::domain(const std::string& name) : _name(name)
 		throw std::logic_error("failed to create log area");
 }
 
-// Create topic.
-// Returns existing topic with same name if data type matches.
-topic* domain::create_topic(const std::string& name, const std::string& data_type)
+domain::~domain()
 {
-	std::unique_lock<std::shared_timed_mutex> lock(_mutex); // read-write exclusive
+	for (size_t i = 0; i < _topics.size(); i++) delete _topics[i];
+}
 
-	// Look for existing topic and validate the data-type
-	for (auto &p : _topics) {
-		if (p->name() == name) {
-			if (p->data_type() == data_type)
-				return p.get();
+// Find or add topic.
+// Returns existing topic with same name if data type and size class match.
+topic_base* domain::add_topic(const std::string& name, const std::string& data_type, const topic_qos& qos,
+		size_t slot_size, bool plain, const std::function<topic_base*()>& make)
+{
+	std::unique_lock<std::mutex> lock(_mutex); // writers only
 
-			hogl::post(_area, _area->ERROR, hogl::arg_gstr("topic %s already exists: data-type %s requested %s"),
-					name, p->data_type(), data_type);
+	// Look for existing topic and validate the data-type
+	auto it = _index.find(name);
+	if (it != _index.end()) {
+		auto p = it->second;
+		bool same_class = p->slot_size() == slot_size && p->plain_only() == plain;
+		if (p->data_type() == data_type && same_class)
+			return p;
+
+		if (p->data_type() == data_type) {
+			hogl::post(_area, _area->ERROR, hogl::arg_gstr("topic %s already exists: slot-size %u plain-only %u requested %u %u"),
+					name, p->slot_size(), p->plain_only(), slot_size, plain);
 			return 0;
 		}
+
+		hogl::post(_area, _area->ERROR, hogl::arg_gstr("topic %s already exists: data-type %s requested %s"),
+				name, p->data_type(), data_type);
+		return 0;
 	}
 
-	// Allocate new topic
-	auto nt = std::make_unique<topic>(_name, name, data_type);
-	auto t  = nt.get();
-	_topics.push_back(std::move(nt));
+	if (!valid(qos)) {
+		hogl::post(_area, _area->ERROR, hogl::arg_gstr("topic %s invalid qos: pool-size %u ring-depth %u"),
+				name, qos.pool_size, qos.ring_depth);
+		return 0;
+	}
+
+	// Allocate new topic, the list owns it once appended
+	std::unique_ptr<topic_base> nt(make());
+	_topics.push_back(nt.get());
+	auto t = nt.release();
+	_index.emplace(std::cref(t->name()), t);
 
-	hogl::post(_area, _area->INFO, hogl::arg_gstr("new-topic %s data-type %s"), t->name(), t->data_type());
+	hogl::post(_area, _area->INFO, hogl::arg_gstr("new-topic %s data-type %s slot-size %u"), t->name(), t->data_type(), t->slot_size());
 	return t;
 }
 
-// T is unique_ptr<topic> in the functions below
-template <typename T>
-static inline bool filter_match(const query::filter& flt, const T& t)
+void domain::add_pool(buffer_pool* p)
+{
+	std::unique_lock<std::mutex> lock(_pool_mutex);
+	_pools.push_back(p);
+}
+
+void domain::remove_pool(buffer_pool* p)
+{
+	std::unique_lock<std::mutex> lock(_pool_mutex);
+	_pools.erase(std::remove(_pools.begin(), _pools.end(), p), _pools.end());
+}
+
+static inline bool filter_match(const query::filter& flt, const topic_base* t)
 {
 	if (flt.topic_name != "any" && flt.topic_name != t->name())
 		return false;
@@ -90,59 +122,71 @@ static inline bool filter_any(const query::filter& flt)
 
 void domain::dump(const query::filter& flt)
 {
-	std::shared_lock<std::shared_timed_mutex> lock(_mutex); // read-only shared
+	// Topics are never deleted, entries below the size are safe to use without the lock
+	size_t n = _topics.size();
 
 	if (filter_any(flt)) {
 		// Full dump with all topics and data types
-		hogl::post(_area, _area->INFO, hogl::arg_gstr("ntopics %u"), _topics.size());
-		for (auto &t : _topics) t->dump();
+		{
+			std::unique_lock<std::mutex> lock(_pool_mutex);
+			hogl::post(_area, _area->INFO, hogl::arg_gstr("ntopics %u npools %u"), n, _pools.size());
+			for (auto &p : _pools) p->dump();
+		}
+		for (size_t i = 0; i < n; i++) _topics[i]->dump();
 	} else {
 		// Filtered dump
-		for (auto &t : _topics) { if (filter_match(flt, t)) t->dump(); }
+		for (size_t i = 0; i < n; i++) { if (filter_match(flt, _topics[i])) _topics[i]->dump(); }
 	}
 }
 
 void domain::kick(const query::filter& flt)
 {
-	std::shared_lock<std::shared_timed_mutex> lock(_mutex); // read-only shared
+	size_t n = _topics.size();
 
 	if (filter_any(flt)) {
 		// Kick all topics
-		for (auto &t : _topics) t->kick();
+		for (size_t i = 0; i < n; i++) _topics[i]->kick();
 	} else  {
 		// Kick topics that match the filter
-		for (auto &t : _topics) { if (filter_match(flt, t)) t->kick(); }
+		for (size_t i = 0; i < n; i++) { if (filter_match(flt, _topics[i])) _topics[i]->kick(); }
 	}
 }
 
 void domain::shutdown(std::chrono::nanoseconds fto)
 {
-	std::shared_lock<std::shared_timed_mutex> lock(_mutex); // read-only shared
-
-	for (auto &t : _topics) t->shutdown(fto);
+	size_t n = _topics.size();
+	for (size_t i = 0; i < n; i++) _topics[i]->shutdown(fto);
 }
 
 void domain::query(query::domain_info& di, const query::filter& flt)
 {
 	di.name = _name;
 
-	std::shared_lock<std::shared_timed_mutex> lock(_mutex); // read-only shared
+	{
+		// Buffer pools are not filtered
+		std::unique_lock<std::mutex> lock(_pool_mutex);
+		di.pools.resize(_pools.size());
+		for (unsigned i=0; i<_pools.size(); i++) _pools[i]->query(di.pools[i]);
+	}
+
+	size_t n = _topics.size();
 
 	if (filter_any(flt)) {
 		// Full output with all topics and data types
-		di.topics.resize(_topics.size());
-		for (unsigned i=0; i<_topics.size(); i++) _topics[i]->query(di.topics[i]);
+		di.topics.resize(n);
+		for (unsigned i=0; i<n; i++) _topics[i]->query(di.topics[i]);
 		return;
 	}
 
 	// Filtered output
-	unsigned int i = 0;
-	for (auto &t: _topics) {
+	unsigned int j = 0;
+	for (unsigned i=0; i<n; i++) {
+		auto t = _topics[i];
 		if (!filter_match(flt, t)) continue;
 
-		di.topics.resize(i + 1);
-		t->query(di.topics[i]);
-		i++;
+		di.topics.resize(j + 1);
+		t->query(di.topics[j]);
+		j++;
 	}
 }
 
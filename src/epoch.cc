@@ -0,0 +1,168 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "vdds/detail/epoch.hpp"
+
+namespace vdds {
+namespace detail {
+
+std::atomic<uint64_t> epoch::_global(1);
+
+namespace {
+
+// Global list of thread records (append only, records are reused)
+std::atomic<epoch::record*> records(nullptr);
+
+// Retired object
+struct retired {
+	void*    ptr;
+	void     (*del)(void*);
+	uint64_t epoch; ///> global epoch at the time of retirement
+};
+
+struct retired_list {
+	std::mutex           mutex;
+	std::vector<retired> items;
+};
+
+// Never destroyed, topics may be deleted during static destruction
+retired_list& retired_objects()
+{
+	static retired_list* rl = new retired_list();
+	return *rl;
+}
+
+// Releases the thread record when the thread exits
+struct record_owner {
+	epoch::record* rec = nullptr;
+	~record_owner() { if (rec) rec->in_use.store(false, std::memory_order_release); }
+};
+
+thread_local record_owner owner;
+
+// Get the oldest epoch announced by active readers (UINT64_MAX if none)
+uint64_t oldest_reader()
+{
+	uint64_t oldest = UINT64_MAX;
+	for (auto r = records.load(std::memory_order_acquire); r; r = r->next) {
+		uint64_t e = r->local.load(std::memory_order_acquire);
+		if (e && e < oldest) oldest = e;
+	}
+	return oldest;
+}
+
+// Free retired objects older than the oldest reader.
+// Called with the retired list locked.
+void reclaim(retired_list& rl)
+{
+	uint64_t oldest = oldest_reader();
+
+	auto& v = rl.items;
+	auto i = std::partition(v.begin(), v.end(), [oldest](const retired& r) { return r.epoch >= oldest; });
+	for (auto j = i; j != v.end(); ++j) j->del(j->ptr);
+	v.erase(i, v.end());
+}
+
+} // anonymous namespace
+
+epoch::record* epoch::attach()
+{
+	// Reuse a record released by a thread that exited
+	for (auto r = records.load(std::memory_order_acquire); r; r = r->next) {
+		bool f = false;
+		if (!r->in_use.load(std::memory_order_relaxed) && r->in_use.compare_exchange_strong(f, true)) {
+			owner.rec = r;
+			return r;
+		}
+	}
+
+	record* r = new record();
+	r->local.store(0, std::memory_order_relaxed);
+	r->in_use.store(true, std::memory_order_relaxed);
+	r->depth = 0;
+	r->next  = records.load(std::memory_order_relaxed);
+	while (!records.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed));
+
+	owner.rec = r;
+	return r;
+}
+
+void epoch::retire(void* p, void (*del)(void*))
+{
+	auto& rl = retired_objects();
+	std::lock_guard<std::mutex> lock(rl.mutex);
+
+	// Readers that announce the new epoch are guaranteed to see the updated pointers.
+	// The fence pairs with the one in enter().
+	uint64_t e = _global.fetch_add(1, std::memory_order_acq_rel);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	rl.items.push_back(retired{p, del, e});
+	reclaim(rl);
+}
+
+void epoch::collect()
+{
+	auto& rl = retired_objects();
+	std::lock_guard<std::mutex> lock(rl.mutex);
+	reclaim(rl);
+}
+
+size_t epoch::pending()
+{
+	auto& rl = retired_objects();
+	std::lock_guard<std::mutex> lock(rl.mutex);
+	return rl.items.size();
+}
+
+void epoch::synchronize()
+{
+	uint64_t e = _global.fetch_add(1, std::memory_order_acq_rel);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Readers are short (topic push/kick), yield first then back off
+	for (unsigned int i = 0; oldest_reader() <= e; i++) {
+		if (i < 64)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+
+	collect();
+}
+
+} // namespace detail
+} // namespace vdds
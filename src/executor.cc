@@ -0,0 +1,242 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdexcept>
+#include <algorithm>
+
+#include "vdds/executor.hpp"
+
+namespace vdds {
+
+// Executor and worker index of the calling thread
+static thread_local executor* tls_executor = nullptr;
+static thread_local unsigned int tls_worker = 0;
+
+void executor::task::notify()
+{
+	// Order the preceding queue push against the state load (pairs with run)
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	uint32_t s = state.load(std::memory_order_relaxed);
+	uint32_t n;
+	do {
+		if (s == queued || s == rerun) return;
+		n = (s == idle) ? queued : rerun;
+	} while (!state.compare_exchange_weak(s, n, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+	if (n == queued) ex.schedule(this);
+}
+
+executor::executor(unsigned int nthreads, size_t batch) :
+	_idle(0), _stop(false), _next(0), _batch(batch ? batch : 1)
+{
+	// Default: one worker per CPU (hardware_concurrency may return 0)
+	if (!nthreads) {
+		nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+		if (nthreads > max_workers) nthreads = max_workers;
+	}
+	if (nthreads > max_workers)
+		throw std::invalid_argument("too many executor threads");
+
+	for (unsigned int i=0; i < nthreads; i++)
+		_workers.emplace_back(new worker());
+	for (unsigned int i=0; i < nthreads; i++)
+		_workers[i]->thread = std::thread([this, i]() { loop(i); });
+}
+
+executor::~executor()
+{
+	_stop.store(true, std::memory_order_release);
+	for (auto &w : _workers) w->nf.shutdown(std::chrono::milliseconds(1));
+	for (auto &w : _workers) w->thread.join();
+
+	// Unsubscribe before the tasks (notifiers) are gone
+	for (auto &t : _tasks) t->owner.reset();
+	_tasks.clear();
+}
+
+std::unique_ptr<executor::task> executor::make_task(priority p)
+{
+	unsigned int h = _next.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+	return std::unique_ptr<task>(new task(*this, static_cast<unsigned int>(p), h));
+}
+
+executor::task* executor::add(std::unique_ptr<task> t)
+{
+	std::lock_guard<std::mutex> lock(_tasks_mutex);
+	_tasks.push_back(std::move(t));
+	return _tasks.back().get();
+}
+
+void executor::remove(task* t)
+{
+	// No new notifications, queued and running callbacks finish without rescheduling
+	t->detach();
+	t->dead.store(true, std::memory_order_seq_cst);
+
+	// Idle tasks are not referenced by the workers (@see run)
+	while (t->state.load(std::memory_order_acquire) != task::idle)
+		std::this_thread::yield();
+
+	// Unsubscribe before the task (notifier) is gone
+	t->owner.reset();
+
+	std::unique_ptr<task> dt;
+	{
+		std::lock_guard<std::mutex> lock(_tasks_mutex);
+		auto it = std::find_if(_tasks.begin(), _tasks.end(),
+				[t](const std::unique_ptr<task>& p) { return p.get() == t; });
+		dt = std::move(*it);
+		_tasks.erase(it);
+	}
+}
+
+void executor::schedule(task* t)
+{
+	// Tasks scheduled from the workers stay on the same worker
+	unsigned int w = (tls_executor == this) ? tls_worker : t->home.load(std::memory_order_relaxed);
+	worker& wk = *_workers[w];
+
+	{
+		std::lock_guard<std::mutex> lock(wk.lock);
+		wk.runq[t->prio].push_back(t);
+	}
+
+	// Wake up the owner if it's idle, or another idle worker to steal the task
+	uint64_t idle = _idle.load(std::memory_order_acquire);
+	if (idle & (uint64_t(1) << w))
+		wk.nf.notify();
+	else if (idle)
+		_workers[__builtin_ctzll(idle)]->nf.notify();
+}
+
+executor::task* executor::next(unsigned int w)
+{
+	size_t n = _workers.size();
+
+	for (unsigned int p=0; p < nprio; p++) {
+		// Own queue, FIFO order
+		{
+			worker& wk = *_workers[w];
+			std::lock_guard<std::mutex> lock(wk.lock);
+			if (!wk.runq[p].empty()) {
+				task* t = wk.runq[p].front();
+				wk.runq[p].pop_front();
+				return t;
+			}
+		}
+
+		// Steal from the other workers (back of the queue)
+		for (size_t i=1; i < n; i++) {
+			worker& vk = *_workers[(w + i) % n];
+			std::lock_guard<std::mutex> lock(vk.lock);
+			if (!vk.runq[p].empty()) {
+				task* t = vk.runq[p].back();
+				vk.runq[p].pop_back();
+				_workers[w]->steal_count.fetch_add(1, std::memory_order_relaxed);
+				return t;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void executor::run(task* t, unsigned int w)
+{
+	t->state.exchange(task::running, std::memory_order_acq_rel);
+	t->home.store(w, std::memory_order_relaxed);
+
+	// Order the state store against the queue pops (pairs with task::notify)
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// Removed tasks are not run anymore, the task must not be touched once idle (@see remove)
+	if (t->dead.load(std::memory_order_acquire)) {
+		t->state.store(task::idle, std::memory_order_release);
+		return;
+	}
+
+	size_t n = t->run(_batch);
+	_workers[w]->run_count.fetch_add(1, std::memory_order_relaxed);
+
+	// Done unless the batch was full or more data showed up while running
+	uint32_t s = task::running;
+	if (n < _batch && t->state.compare_exchange_strong(s, task::idle, std::memory_order_acq_rel))
+		return;
+
+	if (t->dead.load(std::memory_order_acquire)) {
+		t->state.store(task::idle, std::memory_order_release);
+		return;
+	}
+
+	t->state.store(task::queued, std::memory_order_release);
+	schedule(t);
+}
+
+void executor::loop(unsigned int w)
+{
+	tls_executor = this;
+	tls_worker = w;
+
+	worker& wk = *_workers[w];
+	uint64_t bit = uint64_t(1) << w;
+
+	while (!_stop.load(std::memory_order_acquire)) {
+		task* t = next(w);
+		if (t) {
+			run(t, w);
+			continue;
+		}
+
+		// Announce idle and recheck, schedule() may have missed the flag
+		_idle.fetch_or(bit, std::memory_order_seq_cst);
+		t = next(w);
+		if (!t)
+			wk.nf.wait_for(std::chrono::milliseconds(10));
+		_idle.fetch_and(~bit, std::memory_order_seq_cst);
+
+		if (t) run(t, w);
+	}
+}
+
+uint64_t executor::run_count() const
+{
+	uint64_t n = 0;
+	for (auto &w : _workers) n += w->run_count.load(std::memory_order_relaxed);
+	return n;
+}
+
+uint64_t executor::steal_count() const
+{
+	uint64_t n = 0;
+	for (auto &w : _workers) n += w->steal_count.load(std::memory_order_relaxed);
+	return n;
+}
+
+} // namespace vdds
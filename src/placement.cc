@@ -0,0 +1,107 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <unistd.h>
+
+#include "vdds/detail/placement.hpp"
+
+namespace vdds {
+namespace detail {
+
+static const size_t huge_page_size = 2 * 1024 * 1024;
+static const unsigned int max_nodes = 1024;
+
+int current_node()
+{
+	unsigned int cpu = 0, node = 0;
+	if (syscall(SYS_getcpu, &cpu, &node, nullptr) < 0) return 0;
+	return node;
+}
+
+// Round the size up to the page size of the placement
+static size_t map_size(size_t size, const placement& p)
+{
+	size_t page = p.hugepages ? huge_page_size : sysconf(_SC_PAGESIZE);
+	return (size + page - 1) & ~(page - 1);
+}
+
+// Set preferred node for the memory range.
+// Failures are ignored (kernel without NUMA support, invalid node).
+static void set_node(void* addr, size_t size, int node, unsigned int flags)
+{
+	if (node < 0 || unsigned(node) >= max_nodes) return;
+
+	unsigned long mask[max_nodes / (8 * sizeof(unsigned long))] = { 0 };
+	mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+	syscall(SYS_mbind, addr, size, MPOL_PREFERRED, mask, max_nodes, flags);
+}
+
+void* map(size_t size, const placement& p, bool* huge)
+{
+	size = map_size(size, p);
+
+	void* addr = MAP_FAILED;
+	if (p.hugepages)
+		addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (huge)
+		*huge = addr != MAP_FAILED;
+
+	if (addr == MAP_FAILED) {
+		addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (addr == MAP_FAILED)
+			return nullptr;
+
+		// Explicit hugepages are not available, fall back to transparent hugepages
+		if (p.hugepages) madvise(addr, size, MADV_HUGEPAGE);
+	}
+
+	// Pages are not populated yet, the policy applies to the first touch from any thread.
+	// Deferred placement leaves the pages alone until the consumer binds them.
+	if (!p.deferred)
+		set_node(addr, size, p.node, 0);
+
+	return addr;
+}
+
+void bind(void* addr, size_t size, const placement& p, int node)
+{
+	set_node(addr, map_size(size, p), node, MPOL_MF_MOVE);
+}
+
+void unmap(void* addr, size_t size, const placement& p)
+{
+	munmap(addr, map_size(size, p));
+}
+
+} // namespace detail
+} // namespace vdds
@@ -37,11 +37,12 @@
 
 namespace vdds {
 
-pub_handle::pub_handle(const std::string& name, const std::string& topic_name) :
-	_name(name)
+pub_handle::pub_handle(const std::string& name, const std::string& topic_name, unsigned int lane) :
+	_name(name), _lane(lane)
 {
 	// Cache trace format (must be global for hogl::engine)
 	_trace_fmt = strcache::push( fmt::format("vdds-push {} {} # ph:X # seqno:%llu timestamp:%llu nsubs:%u npubs:%u", topic_name, name) );
+	_batch_trace_fmt = strcache::push( fmt::format("vdds-push-batch {} {} # ph:X # seqno:%llu timestamp:%llu count:%u nsubs:%u npubs:%u", topic_name, name) );
 }
 
 } // namespace vdds
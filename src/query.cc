@@ -68,6 +68,7 @@ void clear(domain_info& di)
 {
 	di.name.clear();
 	di.topics.clear();
+	di.pools.clear();
 }
 
 } // namespace query
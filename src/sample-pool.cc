@@ -0,0 +1,71 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdexcept>
+
+#include "vdds/sample.hpp"
+
+namespace vdds {
+
+template<typename D>
+size_t basic_sample_pool<D>::valid_size(size_t n)
+{
+	// Free list indices are 32-bit, UINT32_MAX is reserved
+	if (!n || n >= UINT32_MAX)
+		throw std::invalid_argument("invalid sample pool size");
+	return n;
+}
+
+template<typename D>
+basic_sample_pool<D>::basic_sample_pool(size_t n) :
+	_samples(new sample[valid_size(n)]), _free(n), _exhausted(0)
+{
+	// Push in reverse order so that the first get() returns the first sample
+	for (size_t i = n; i > 0; i--) {
+		sample& s = _samples[i - 1];
+		s.refcnt = 0;
+		s.pool   = this;
+		_free.push(static_cast<uint32_t>(i - 1));
+	}
+}
+
+// Size classes
+template class basic_sample_pool<data64>;
+template class basic_sample_pool<data128>;
+template class basic_sample_pool<data256>;
+template class basic_sample_pool<data1k>;
+template class basic_sample_pool<data4k>;
+template class basic_sample_pool<plain64>;
+template class basic_sample_pool<plain128>;
+template class basic_sample_pool<plain256>;
+template class basic_sample_pool<plain1k>;
+template class basic_sample_pool<plain4k>;
+
+} // namespace vdds
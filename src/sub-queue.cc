@@ -37,13 +37,98 @@
 
 namespace vdds {
 
-sub_queue::sub_queue(const std::string& name, const std::string& topic_name,
-		const std::string& dt, size_t capacity, vdds::notifier *n) :
-	_fifo(capacity), _drop_count(0), _push_count(0), _notifier(n),
-	_name(name), _data_type(dt), _capacity(capacity)
+// Resolve the queue slot placement
+static detail::placement placement_of(const sub_qos& qos)
+{
+	detail::placement p;
+	if (qos.numa == sub_qos::numa_policy::local)
+		p.deferred = true; // bound by the consumer thread (@see bind_local)
+	if (qos.numa == sub_qos::numa_policy::node)
+		p.node = qos.numa_node;
+	p.hugepages = qos.hugepages;
+	return p;
+}
+
+template<typename D>
+basic_sub_queue<D>::basic_sub_queue(const std::string& name, const std::string& topic_name,
+		const std::string& dt, size_t capacity, vdds::notifier *n, backend b, const sub_qos& qos) :
+	_placement(placement_of(qos)), _node(-1), _unbound(_placement.deferred),
+	_fifo(b == backend::fifo ? capacity : 1, detail::slot_allocator<data>(b == backend::fifo ? _placement : detail::placement())),
+	_mpsc_drop_count(0),
+	_nlanes(std::max(qos.max_lanes, 1u)), _rr_lane(0), _order(qos.order),
+	_hist_head(0), _overwrite_count(0),
+	_ring(nullptr), _head(nullptr), _cursor(0), _start(0),
+	_drop_count(0), _push_count(0), _notifier(n), _refcnt(0),
+	_name(name), _data_type(dt), _capacity(capacity),
+	_reliable(qos.reliability == sub_qos::reliability_policy::reliable),
+	_bp(qos.wait), _max_blocking(qos.max_blocking), _waiters(0),
+	_filter(qos.filter), _filter_count(0),
+	_decimation(qos.decimation), _min_interval(std::max<int64_t>(qos.min_interval.count(), 0)),
+	_decimate_seq(0), _next_timestamp(0), _decimate_count(0)
 { 
+	if (b == backend::pool)
+		_refs.reset(new fifo_queue<sample*>(capacity, detail::slot_allocator<sample*>(_placement)));
+	if (b == backend::mpsc)
+		_mpsc.reset(new detail::mpsc_queue<data>(capacity));
+	if (_reliable && _bp == sub_qos::backpressure::wait)
+		_room.reset(new notifier_cv());
+	if (b == backend::last) {
+		// Same as the topic broadcast ring but private to this queue
+		_hist.reset(new detail::bcast_ring<data>(capacity ? capacity : 1));
+		attach(_hist.get(), &_hist_head);
+	}
+	if (b == backend::lanes) {
+		// Lanes are allocated as publishers show up (@see add_lane)
+		_lanes.reset(new std::atomic<lane*>[_nlanes]);
+		for (unsigned int i=0; i < _nlanes; i++)
+			_lanes[i].store(nullptr, std::memory_order_relaxed);
+	}
+
 	// Cache trace format (must be global for hogl::engine)
 	_trace_fmt = strcache::push( fmt::format("vdds-pop {} {} # ph:X # seqno:%llu timestamp:%llu", topic_name, name) );
+	_drain_trace_fmt = strcache::push( fmt::format("vdds-drain {} {} # ph:X # seqno:%llu timestamp:%llu count:%u", topic_name, name) );
+}
+
+template<typename D>
+void basic_sub_queue<D>::bind_local()
+{
+	_unbound = false;
+	if (!_placement.deferred || _node.load(std::memory_order_relaxed) >= 0) return;
+
+	// Lanes added after this point are bound by add_lane()
+	int node = detail::current_node();
+	_node.store(node, std::memory_order_seq_cst);
+
+	bind(_fifo, node);
+	if (_refs) bind(*_refs, node);
+	for (unsigned int i=0; _lanes && i < _nlanes; i++) {
+		lane* l = _lanes[i].load(std::memory_order_seq_cst);
+		if (l) bind(l->fifo, node);
+	}
+}
+
+template<typename D>
+basic_sub_queue<D>::~basic_sub_queue()
+{
+	_unbound = false;
+
+	sample* s;
+	while (pop(s)) s->pool->put(s);
+
+	for (unsigned int i=0; _lanes && i < _nlanes; i++)
+		delete _lanes[i].load(std::memory_order_relaxed);
 }
 
+// Size classes
+template class basic_sub_queue<data64>;
+template class basic_sub_queue<data128>;
+template class basic_sub_queue<data256>;
+template class basic_sub_queue<data1k>;
+template class basic_sub_queue<data4k>;
+template class basic_sub_queue<plain64>;
+template class basic_sub_queue<plain128>;
+template class basic_sub_queue<plain256>;
+template class basic_sub_queue<plain1k>;
+template class basic_sub_queue<plain4k>;
+
 } // namespace vdds
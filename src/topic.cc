@@ -29,6 +29,9 @@
 //  SPDX-License-Identifier: BSD-3-Clause
 
 #include <stdexcept>
+#include <algorithm>
+#include <climits>
+#include <thread>
 
 #include <hogl/area.hpp>
 #include <hogl/post.hpp>
@@ -38,55 +41,115 @@
 
 namespace vdds {
 
-topic::topic(const std::string& domain, const std::string& name, const std::string& data_type) :
-	_domain(domain), _name(name), _data_type(data_type),
-	_next_seqno(0),
-	_cache_ptr(new cache()),
-	_cache_refcnt(0)
-{ 
+topic_base::topic_base(const std::string& domain, const std::string& name, const std::string& data_type,
+		const topic_qos& qos, size_t slot_size, bool plain) :
+	_domain(domain), _name(name), _data_type(data_type), _qos(qos), _slot_size(slot_size), _plain(plain)
+{
 	_area = hogl::add_area(fmt::format("VDDS{}{}", _domain.empty() ? "" : "-", _domain).c_str());
 	if (!_area)
 		throw std::logic_error("failed to create log area");
+
+	if (!valid(_qos))
+		throw std::invalid_argument("invalid topic qos");
 }
 
-topic::~topic()
+template<typename D>
+basic_topic<D>::basic_topic(const std::string& domain, const std::string& name, const std::string& data_type,
+		const topic_qos& qos) :
+	topic_base(domain, name, data_type, qos, sizeof(D), std::is_trivially_copyable<D>::value),
+	_durable_count(0),
+	_next_seqno(0),
+	_lockless_waiters(0),
+	_cache_ptr(new cache())
+{ 
+	if (_qos.pool_size)
+		_pool.reset(new sample_pool(_qos.pool_size));
+	if (_qos.ring_depth)
+		_ring.reset(new detail::bcast_ring<data>(_qos.ring_depth));
+	if (_qos.durability_depth && !_ring)
+		_durable.resize(_qos.durability_depth);
+}
+
+template<typename D>
+basic_topic<D>::~basic_topic()
 {
 	cache* c = _cache_ptr;
-	delete c;
+	cache::release(c);
 }
 
 // Create a copy of the cache
-topic::cache* topic::cache_copy()
+template<typename D>
+typename basic_topic<D>::cache* basic_topic<D>::cache_copy()
 {
 	const cache* cc = _cache_ptr.load();
 	return new cache(*cc);
 }
 
-void topic::cache_swap(cache *nc)
+template<typename D>
+void basic_topic<D>::cache_swap(cache *nc)
 {
-	const cache* cc = _cache_ptr.load();
-
 	// Replace the cache pointer.
-	_cache_ptr.exchange(nc);
+	cache* cc = _cache_ptr.exchange(nc);
 
 	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s swapped cache: %p to %p"), _name, (void *) cc, (void *) nc);
 
 	// At this point all new topic::push() operations will use the new cache.
-	// To release the old cache we have to wait for the refcount to drop to zero.
-	while (_cache_refcnt.load() != 0);
-
-	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s deleting old cache: %p"), _name, (void *) cc);
+	// Operations in flight may still use the old one, it's freed after they are done.
+	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s retiring old cache: %p"), _name, (void *) cc);
 
-	delete cc;
+	detail::epoch::retire(cc, [](void* p) { cache::release(static_cast<cache*>(p)); });
 }
 
-sub_queue* topic::subscribe(const std::string& name, unsigned int qsize, notifier* ntfr)
+template<typename D>
+typename basic_topic<D>::sub_queue* basic_topic<D>::subscribe(const std::string& name, unsigned int qsize, notifier* ntfr, const sub_qos& qos)
 {
-	sub_queue *q = new sub_queue(name, this->name(), _data_type, qsize, ntfr);
+	bool keep_last = qos.history == sub_qos::history_policy::keep_last;
+	if (keep_last && (_pool || _ring)) {
+		hogl::post(_area, _area->ERROR, hogl::arg_gstr("%s keep_last history is not supported with sample pool and ring (sub %s)"),
+				_name, name);
+		return nullptr;
+	}
+
+	bool reliable = qos.reliability == sub_qos::reliability_policy::reliable;
+	if (reliable && (keep_last || _pool || _ring)) {
+		hogl::post(_area, _area->ERROR, hogl::arg_gstr("%s reliable sub %s requires drop_newest history and topic without sample pool and ring"),
+				_name, name);
+		return nullptr;
+	}
+
+	// multi_pub mode is irrelevant for keep_last queues (lock-free for any number of publishers)
+	auto b = sub_queue::backend::fifo;
+	if (_ring)
+		b = sub_queue::backend::ring;
+	else if (_pool)
+		b = sub_queue::backend::pool;
+	else if (keep_last)
+		b = sub_queue::backend::last;
+	else if (qos.multi_pub == sub_qos::mpub::lockfree)
+		b = sub_queue::backend::mpsc;
+	else if (qos.multi_pub == sub_qos::mpub::lanes)
+		b = sub_queue::backend::lanes;
+
+	sub_queue *q = new sub_queue(name, this->name(), _data_type, qsize, ntfr, b, qos);
+
+	// Durable topics: the history is preloaded and the queue is registered under the durable lock.
+	// Publishers take the seqno and the cache under the same lock (@see stamp), so the samples
+	// up to the current seqno come from the history, and the following ones are pushed live.
+	auto dl = durable_lock();
 
 	std::unique_lock<std::shared_timed_mutex> lock(_mutex); // read-write / exclusive mode
 
+	// Ring subscribers start reading at the current head (or behind it on durable topics)
+	if (_ring) q->attach(_ring.get(), &_next_seqno, _qos.durability_depth);
+
+	if (!_durable.empty()) preload(q);
+
 	cache* c = cache_copy();
+
+	// Lanes for the existing publishers
+	for (auto &p : c->pubs) q->add_lane(p->lane());
+
+	q->get();
 	c->subs.push_back(q);
 	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s add-sub: %s queue %p qcap %u notifier %s"),
 			_name, q->name(), q, q->capacity(), ntfr ? ntfr->name() : std::string("null") );
@@ -95,35 +158,110 @@ sub_queue* topic::subscribe(const std::string& name, unsigned int qsize, notifie
 	return q;
 }
 
-void topic::unsubscribe(sub_queue *q)
+template<typename D>
+void basic_topic<D>::preload(sub_queue* q)
 {
-	std::unique_lock<std::shared_timed_mutex> lock(_mutex); // read-write / exclusive mode
-
-	cache* c = cache_copy();
-	auto i = std::find(c->subs.begin(), c->subs.end(), q);
-	if (i != c->subs.end())
-		c->subs.erase(i);
-	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s del-sub: %s queue %p"), _name, q->name(), q);
-	cache_swap(c);
+	// Newest samples that fit into the queue, oldest first
+	uint64_t depth = _durable.size();
+	uint64_t n = std::min<uint64_t>({ _durable_count, depth, q->capacity() });
+
+	// Lanes queues get the history in the shared lane
+	q->add_lane(UINT_MAX);
+
+	for (uint64_t i = _durable_count - n; i < _durable_count; i++) {
+		const data& d = _durable[i % depth];
+		if (!q->accept(d)) continue;
+
+		if (!_pool) {
+			q->push(d);
+			continue;
+		}
+
+		sample* s = _pool->get();
+		if (!s) {
+			q->drop();
+			continue;
+		}
+		s->d = d;
+		s->refcnt.store(1, std::memory_order_relaxed);
+		if (!q->push(s)) _pool->put(s);
+	}
 
-	delete q;
+	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s preloaded %u samples into %s, live from seqno %llu"),
+			_name, n, q->name(), _next_seqno.load(std::memory_order_relaxed));
 }
 
-pub_handle* topic::publish(const std::string& name)
+template<typename D>
+void basic_topic<D>::unsubscribe(sub_queue *q)
 {
-	pub_handle* p = new pub_handle(name, this->name());
+	// Keep the queue alive until we're done with it below
+	q->get();
+
+	{
+		std::unique_lock<std::shared_timed_mutex> lock(_mutex); // read-write / exclusive mode
+
+		cache* c = cache_copy();
+		auto i = std::find(c->subs.begin(), c->subs.end(), q);
+		if (i != c->subs.end()) {
+			c->subs.erase(i);
+			q->put();
+		}
+		hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s del-sub: %s queue %p"), _name, q->name(), q);
+		cache_swap(c);
+	}
+
+	// Publishers that still use the old cache may be pushing into the queue. The queue is
+	// deleted once the retired caches that list it are reclaimed, we don't wait for them.
+	// The notifier is owned by the caller, publishers stop kicking it before we return
+	// (waits for the epoch grace period, publishers blocked on reliable queues are outside).
+	q->detach();
 
+	// Drop queued data now, the data pushed by the publishers in flight is dropped on reclamation
+	q->flush();
+
+	q->put();
+}
+
+template<typename D>
+pub_handle* basic_topic<D>::publish(const std::string& name)
+{
 	std::unique_lock<std::shared_timed_mutex> lock(_mutex); // read-write / exclusive mode
 
 	cache* c = cache_copy();
+	bool nl = need_lock(c);
+
+	// Allocate the lowest free lane index.
+	// Lanes are reused once the previous owner is unpublished.
+	unsigned int lane = 0;
+	while (std::any_of(c->pubs.begin(), c->pubs.end(), [lane](const pub_handle* p) { return p->lane() == lane; }))
+		lane++;
+
+	pub_handle* p = new pub_handle(name, this->name(), lane);
+
+	// Lanes must be in place before the publisher can push
+	for (auto &q : c->subs) q->add_lane(lane);
+
 	c->pubs.push_back(p);
-	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s add-pub: %s handle %p"), _name, p->name(), p);
+	hogl::post(_area, _area->DEBUG, hogl::arg_gstr("%s add-pub: %s handle %p lane %u"), _name, p->name(), p, lane);
 	cache_swap(c);
 
+	// The first publisher may be in the middle of a lockless push using the old cache
+	// (reliable pushes can keep retrying for a while). The new publisher must not push
+	// until it's done, otherwise both end up in the single-producer fifo.
+	// Pushes blocked on a reliable queue are outside of the epoch critical section,
+	// they announce themselves before leaving it (@see reliable_op).
+	if (!nl && need_lock(c)) {
+		lock.unlock();
+		detail::epoch::synchronize();
+		while (_lockless_waiters.load(std::memory_order_acquire))
+			std::this_thread::yield();
+	}
+
 	return p;
 }
 
-void topic::unpublish(pub_handle* p)
+template<typename D>
+void basic_topic<D>::unpublish(pub_handle* p)
 {
 	std::unique_lock<std::shared_timed_mutex> lock(_mutex); // read-write / exclusive mode
 
@@ -137,20 +275,36 @@ void topic::unpublish(pub_handle* p)
 	delete p;
 }
 
-void topic::dump()
+template<typename D>
+void basic_topic<D>::dump()
 {
 	std::shared_lock<std::shared_timed_mutex> lock(_mutex); // read-only / shared mode
 
 	const cache* c = _cache_ptr;
 
-	hogl::post(_area, _area->INFO, hogl::arg_gstr("%s nsubs %u npubs %u seqno %llu"),
-			_name, c->subs.size(), c->pubs.size(), (uint64_t) _next_seqno);
+	hogl::post(_area, _area->INFO, hogl::arg_gstr("%s nsubs %u npubs %u seqno %llu slot-size %u plain-only %u"),
+			_name, c->subs.size(), c->pubs.size(), (uint64_t) _next_seqno, _slot_size, _plain);
+
+	if (_pool) {
+		hogl::post(_area, _area->INFO, hogl::arg_gstr("%s pool size %u available %u exhausted %llu"),
+				_name, _pool->size(), _pool->available(), _pool->exhausted_count());
+	}
+	if (_ring) {
+		hogl::post(_area, _area->INFO, hogl::arg_gstr("%s ring depth %u"), _name, _ring->depth());
+	}
+	if (_qos.durability_depth) {
+		hogl::post(_area, _area->INFO, hogl::arg_gstr("%s durability depth %u"), _name, _qos.durability_depth);
+	}
 
 	for (auto &s : c->subs) {
-		hogl::post(_area, _area->INFO, hogl::arg_gstr("%s sub %s queue %p qcap %u qsize %u notifier %s pushes %llu drops %llu"),
+		hogl::post(_area, _area->INFO, hogl::arg_gstr("%s sub %s queue %p qcap %u qsize %u notifier %s pushes %llu drops %llu overwrites %llu filtered %llu decimated %llu"),
 				_name, s->name(), s, s->capacity(), s->size(),
 				s->notifier() ? s->notifier()->name() : std::string("null"),
-				s->push_count(), s->drop_count());
+				s->push_count(), s->drop_count(), s->overwrite_count(), s->filter_count(), s->decimate_count());
+		for (unsigned int l=0; l < s->lanes(); l++) {
+			hogl::post(_area, _area->INFO, hogl::arg_gstr("%s sub %s lane %u drops %u"),
+					_name, s->name(), l, s->lane_drop_count(l));
+		}
 	}
 	for (auto &p : c->pubs) {
 		hogl::post(_area, _area->INFO, hogl::arg_gstr("%s pub %s (%p)"),
@@ -158,7 +312,8 @@ void topic::dump()
 	}
 }
 
-void topic::query(query::topic_info& ti)
+template<typename D>
+void basic_topic<D>::query(query::topic_info& ti)
 {
 	std::shared_lock<std::shared_timed_mutex> lock(_mutex); // read-only / shared mode
 
@@ -166,6 +321,7 @@ void topic::query(query::topic_info& ti)
 
 	ti.name = _name;
 	ti.data_type = _data_type; 
+	ti.slot_size = _slot_size;
 	ti.push_count = _next_seqno;
 	ti.subs.resize(c->subs.size());
 	ti.pubs.resize(c->pubs.size());
@@ -176,6 +332,14 @@ void topic::query(query::topic_info& ti)
 		ti.subs[i].qsize      = c->subs[i]->size();
 		ti.subs[i].push_count = c->subs[i]->push_count();
 		ti.subs[i].drop_count = c->subs[i]->drop_count();
+		ti.subs[i].overwrite_count = c->subs[i]->overwrite_count();
+		ti.subs[i].filter_count = c->subs[i]->filter_count();
+		ti.subs[i].decimate_count = c->subs[i]->decimate_count();
+
+		auto nlanes = c->subs[i]->lanes();
+		ti.subs[i].lane_drop_count.resize(nlanes);
+		for (unsigned l=0; l < nlanes; l++)
+			ti.subs[i].lane_drop_count[l] = c->subs[i]->lane_drop_count(l);
 	}
 
 	for (unsigned i=0; i< c->pubs.size(); i++) {
@@ -183,4 +347,16 @@ void topic::query(query::topic_info& ti)
 	}
 }
 
+// Size classes
+template class basic_topic<data64>;
+template class basic_topic<data128>;
+template class basic_topic<data256>;
+template class basic_topic<data1k>;
+template class basic_topic<data4k>;
+template class basic_topic<plain64>;
+template class basic_topic<plain128>;
+template class basic_topic<plain256>;
+template class basic_topic<plain1k>;
+template class basic_topic<plain4k>;
+
 } // namespace vdds
@@ -0,0 +1,82 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/waitset.hpp"
+
+namespace vdds {
+
+waitset::waitset(unsigned int capacity) :
+	_ready(new std::atomic<uint64_t>[(capacity + 63) / 64]),
+	_capacity(capacity)
+{
+	for (unsigned int i=0; i < (capacity + 63) / 64; i++)
+		_ready[i].store(0, std::memory_order_relaxed);
+	_members.reserve(capacity);
+}
+
+waitset::member* waitset::add()
+{
+	if (_members.size() >= _capacity)
+		return nullptr;
+
+	_members.emplace_back(new member(*this, _members.size()));
+	return _members.back().get();
+}
+
+size_t waitset::collect(std::vector<unsigned int>& ready)
+{
+	for (unsigned int w=0; w < (_members.size() + 63) / 64; w++) {
+		if (!_ready[w].load(std::memory_order_relaxed))
+			continue;
+
+		uint64_t v = _ready[w].exchange(0, std::memory_order_acquire);
+		while (v) {
+			unsigned int b = __builtin_ctzll(v);
+			ready.push_back(w * 64 + b);
+			v &= v - 1;
+		}
+	}
+
+	// Pairs with the fence in set(): data pushed before a skipped set is visible to the caller
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	return ready.size();
+}
+
+size_t waitset::wait(std::vector<unsigned int>& ready, std::chrono::nanoseconds t)
+{
+	ready.clear();
+	if (collect(ready))
+		return ready.size();
+
+	_nf.wait_for(t);
+	return collect(ready);
+}
+
+} // namespace vdds
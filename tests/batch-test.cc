@@ -0,0 +1,217 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Batch publish and drain test
+
+struct batch_msg : vdds::data {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+	uint64_t  count() const { return *reinterpret_cast<const uint64_t*>(&this->plain); }
+};
+const char* batch_msg::data_type = "vdds.test.batch";
+
+// Notifier that counts notifications
+class notifier_count : public vdds::notifier {
+public:
+	std::atomic<uint32_t> count;
+
+	notifier_count() : vdds::notifier("count"), count(0) {}
+
+	void wait_for(std::chrono::nanoseconds t) override { std::this_thread::sleep_for(t); }
+	void notify() override { count++; }
+};
+
+static bool run_batch_test(const char* mode_name, const vdds::topic_qos& tqos, const vdds::sub_qos& sqos)
+{
+	hogl::post(area, area->INFO, "batch test: %s", mode_name);
+
+	vdds::domain vd("DEFAULT");
+	vd.create_topic("/test/batch", batch_msg::data_type, tqos);
+
+	static const unsigned int qsize = 32;
+	static const unsigned int n_msgs = 100;
+
+	notifier_count nf;
+	vdds::sub<batch_msg> sub0(vd, "sub0", "/test/batch", qsize, &nf, sqos);
+	vdds::pub<batch_msg> pub0(vd, "pub0", "/test/batch");
+
+	// Regular push to move seqno
+	batch_msg m; m.count() = 0;
+	pub0.push(m);
+	sub0.pop(m);
+	nf.count = 0;
+
+	std::vector<batch_msg> batch(n_msgs);
+	for (unsigned int i=0; i<n_msgs; i++) { batch[i].timestamp = i; batch[i].count() = i; }
+
+	pub0.push_batch(batch.data(), batch.size());
+
+	for (unsigned int i=0; i<n_msgs; i++) {
+		if (batch[i].seqno != i + 1) {
+			hogl::post(area, area->ERROR, "%s: unexpected seqno %llu at %u", mode_name, batch[i].seqno, i);
+			return false;
+		}
+	}
+
+	if (nf.count != 1) {
+		hogl::post(area, area->ERROR, "%s: unexpected notify count %u", mode_name, (unsigned) nf.count);
+		return false;
+	}
+
+	// Queues keep the head of the batch, the ring keeps the tail
+	uint64_t first = tqos.ring_depth ? n_msgs - qsize : 0;
+	unsigned int n = 0;
+	bool valid = true;
+	auto check = [&](const batch_msg& m) {
+		auto count = m.count();
+		if (m.seqno != first + n + 1 || count != first + n) {
+			hogl::post(area, area->ERROR, "%s: unexpected seqno %llu count %llu", mode_name, m.seqno, count);
+			valid = false;
+		}
+		n++;
+	};
+
+	// Partial drain, then the rest
+	if (sub0.drain(check, 10) != 10 || sub0.drain(check) != qsize - 10 || sub0.pop(m) || !valid) {
+		hogl::post(area, area->ERROR, "%s: drain failed (n %u)", mode_name, n);
+		return false;
+	}
+
+	auto q = sub0.queue();
+	if (n != qsize || q->push_count() != n_msgs + 1 || q->drop_count() != n_msgs - qsize) {
+		hogl::post(area, area->ERROR, "%s: popped %u push-count %u drops %u", mode_name, n, q->push_count(), q->drop_count());
+		return false;
+	}
+
+	vd.dump();
+	return true;
+}
+
+// Multiple publishers pushing batches into lock-free queues
+static bool run_stress_test(const char* mode_name, const vdds::sub_qos& sqos)
+{
+	hogl::post(area, area->INFO, "batch stress test: %s", mode_name);
+
+	vdds::domain vd("DEFAULT");
+
+	static const unsigned int n_pubs  = 4;
+	static const unsigned int n_iters = 10000;
+	static const unsigned int n_batch = 16;
+
+	vdds::notifier_cv nf;
+	vdds::sub<batch_msg> sub0(vd, "sub0", "/test/batch", 256, &nf, sqos);
+
+	std::atomic_bool failed(false);
+	std::atomic_bool done(false);
+
+	uint64_t popped = 0;
+	std::thread sthread([&]() {
+		std::vector<uint64_t> next(n_pubs, 0);
+		auto drain = [&]() {
+			popped += sub0.drain([&](const batch_msg& m) {
+				uint64_t pid = m.timestamp;
+				uint64_t count = m.count();
+				if (pid >= n_pubs || count < next[pid]) {
+					hogl::post(area, area->ERROR, "%s: out of order data pub %llu count %llu", mode_name, pid, count);
+					failed = true;
+				} else
+					next[pid] = count + 1;
+			});
+		};
+		while (!done) {
+			nf.wait_for(std::chrono::milliseconds(10));
+			drain();
+		}
+		drain();
+	});
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int i=0; i<n_pubs; i++) {
+		pthreads.push_back(std::thread([&, i]() {
+			vdds::pub<batch_msg> p(vd, fmt::format("pub{}", i), "/test/batch");
+			batch_msg b[n_batch];
+			uint64_t count = 0;
+			for (unsigned int n=0; n<n_iters; n++) {
+				for (auto &m : b) { m.timestamp = i; m.count() = count++; }
+				p.push_batch(b, n_batch);
+			}
+		}));
+	}
+
+	for (auto &t : pthreads) t.join();
+	done = true;
+	sthread.join();
+
+	auto q = sub0.queue();
+	if (q->push_count() != n_pubs * n_iters * n_batch || popped + q->drop_count() != n_pubs * n_iters * n_batch) {
+		hogl::post(area, area->ERROR, "%s: push-count %u popped %llu drops %u", mode_name, q->push_count(), popped, q->drop_count());
+		failed = true;
+	}
+
+	return !failed;
+}
+
+bool run_test()
+{
+	vdds::topic_qos tqos;
+	vdds::sub_qos   sqos;
+
+	if (!run_batch_test("fifo", tqos, sqos))
+		return false;
+
+	sqos.multi_pub = vdds::sub_qos::mpub::lockfree;
+	if (!run_batch_test("mpsc", tqos, sqos) || !run_stress_test("mpsc", sqos))
+		return false;
+
+	sqos.multi_pub = vdds::sub_qos::mpub::lanes;
+	if (!run_batch_test("lanes", tqos, sqos) || !run_stress_test("lanes", sqos))
+		return false;
+
+	sqos = vdds::sub_qos();
+	tqos.pool_size = 256;
+	if (!run_batch_test("pool", tqos, sqos))
+		return false;
+
+	tqos.pool_size = 0;
+	tqos.ring_depth = 32;
+	if (!run_batch_test("ring", tqos, sqos))
+		return false;
+
+	return true;
+}
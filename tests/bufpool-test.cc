@@ -0,0 +1,267 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+#include "vdds/buffer-pool.hpp"
+
+#include <thread>
+#include <vector>
+#include <cstring>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Frame descriptor with a pooled payload
+struct frame_msg : vdds::data {
+	static const char* data_type;
+
+	struct payload {
+		uint64_t count;
+	};
+
+	payload* get_payload() { return reinterpret_cast<payload*>(&this->plain); }
+	vdds::buffer_pool::buffer* buffer() { return vdds::buffer_pool::from(this->shared); }
+};
+const char* frame_msg::data_type = "vdds.test.frame-msg";
+
+static const unsigned int n_bufs = 64;
+static const unsigned int n_subs = 4;
+static const unsigned int n_msgs = 20000;
+static const size_t buf_size = 1000;
+
+// Fill the buffer with the pattern derived from the count
+static void fill(vdds::buffer_pool::buffer* b, uint64_t count)
+{
+	std::memset(b->data, uint8_t(count), b->size);
+}
+
+static bool check(vdds::buffer_pool::buffer* b, uint64_t count)
+{
+	for (size_t i=0; i<b->size; i++)
+		if (b->data[i] != uint8_t(count)) return false;
+	return true;
+}
+
+// Get all buffers from the pool and release them
+static bool cycle_all(vdds::buffer_pool& pool)
+{
+	std::vector<vdds::shared_handle> v;
+	for (unsigned int i=0; i<pool.count(); i++) {
+		auto h = pool.get();
+		if (!h) {
+			hogl::post(area, area->ERROR, "%s: only %u out of %u buffers returned", pool.name(), i, pool.count());
+			return false;
+		}
+		v.push_back(std::move(h));
+	}
+
+	// Pool is empty now
+	if (pool.get()) {
+		hogl::post(area, area->ERROR, "%s: got more buffers than allocated", pool.name());
+		return false;
+	}
+	return true;
+}
+
+static bool run_fanout_test()
+{
+	hogl::post(area, area->INFO, "fanout test");
+
+	vdds::domain vd("DEFAULT");
+	vdds::buffer_pool pool(vd, "frames", n_bufs, buf_size);
+
+	vdds::pub<frame_msg> pub(vd, "pub0", "/test/frames");
+
+	std::atomic_bool failed(false);
+	std::atomic_bool done(false);
+
+	// Reliable delivery, so that most buffers are released by the subscriber threads
+	vdds::sub_qos qos;
+	qos.reliability = vdds::sub_qos::reliability_policy::reliable;
+	qos.wait = vdds::sub_qos::backpressure::yield;
+	qos.max_blocking = std::chrono::seconds(1);
+
+	std::vector<std::unique_ptr<vdds::sub<frame_msg>>> subs;
+	for (unsigned int i=0; i<n_subs; i++)
+		subs.emplace_back(new vdds::sub<frame_msg>(vd, fmt::format("sub{}", i), "/test/frames", 16, nullptr, qos));
+
+	// Subscribers validate the payload and drop the buffer references
+	std::vector<std::thread> sthreads;
+	for (unsigned int i=0; i<n_subs; i++) {
+		sthreads.push_back(std::thread([&, i]() {
+			auto& s = *subs[i];
+			auto drain = [&]() {
+				frame_msg m;
+				while (s.pop(m)) {
+					if (!m.buffer() || !check(m.buffer(), m.get_payload()->count)) {
+						hogl::post(area, area->ERROR, "%s: corrupted buffer count %llu", s.name(), m.get_payload()->count);
+						failed = true;
+					}
+					m.shared.reset();
+				}
+			};
+			while (!done) {
+				drain();
+				std::this_thread::yield();
+			}
+			drain();
+		}));
+	}
+
+	// Publisher waits for the buffers to come back when the pool is exhausted
+	for (unsigned int n=0; n<n_msgs; n++) {
+		frame_msg m;
+		while (!(m.shared = pool.get()))
+			std::this_thread::yield();
+
+		fill(m.buffer(), n);
+		m.get_payload()->count = n;
+		pub.push(m);
+	}
+
+	done = true;
+	for (auto &t : sthreads) t.join();
+
+	vd.dump();
+
+	// Subscriber threads are gone, all buffers must be back in the pool
+	if (!cycle_all(pool))
+		return false;
+
+	vdds::query::domain_info di;
+	vd.query(di);
+	if (di.pools.size() != 1) {
+		hogl::post(area, area->ERROR, "unexpected number of pools %u", di.pools.size());
+		return false;
+	}
+
+	auto& pi = di.pools[0];
+	hogl::post(area, area->INFO, "pool %s hits %llu misses %llu exhausted %llu",
+		pi.name, pi.hit_count, pi.miss_count, pi.exhausted_count);
+
+	if (pi.name != "frames" || pi.count != n_bufs || pi.buffer_size != buf_size) {
+		hogl::post(area, area->ERROR, "invalid pool info");
+		return false;
+	}
+
+	// Every get is either a cache hit, a miss or a failure (last get in cycle_all)
+	if (pi.hit_count + pi.miss_count != n_msgs + n_bufs || pi.exhausted_count < 1) {
+		hogl::post(area, area->ERROR, "invalid pool stats");
+		return false;
+	}
+
+	return !failed;
+}
+
+// Buffers released by an idle subscriber thread must be available to the publisher
+static bool run_handoff_test()
+{
+	hogl::post(area, area->INFO, "handoff test");
+
+	vdds::domain vd("DEFAULT");
+	vdds::buffer_pool pool(vd, "handoff", 256, buf_size);
+
+	vdds::pub<frame_msg> pub(vd, "pub0", "/test/handoff");
+	vdds::sub<frame_msg> sub(vd, "sub0", "/test/handoff", 1024);
+
+	std::atomic<unsigned int> released(0);
+	std::atomic_bool done(false);
+
+	// Releaser stays alive (and idle) while the publisher cycles the pool
+	std::thread sthread([&]() {
+		while (!done) {
+			frame_msg m;
+			while (sub.pop(m)) {
+				m.shared.reset();
+				released++;
+			}
+			std::this_thread::yield();
+		}
+	});
+
+	for (unsigned int n=0; n<pool.count(); n++) {
+		frame_msg m;
+		m.shared = pool.get();
+		m.get_payload()->count = n;
+		pub.push(m);
+	}
+
+	while (released < pool.count())
+		std::this_thread::yield();
+
+	bool r = cycle_all(pool);
+
+	done = true;
+	sthread.join();
+	return r;
+}
+
+static bool run_hugepage_test()
+{
+	hogl::post(area, area->INFO, "hugepage test");
+
+	vdds::domain vd("DEFAULT");
+
+	// Explicit hugepages are typically not reserved, the pool falls back to regular pages
+	vdds::buffer_pool pool(vd, "huge", 8, 64 * 1024, true /* hugepages */);
+	hogl::post(area, area->INFO, "pool %s hugepages %u", pool.name(), pool.hugepages());
+
+	{
+		auto h = pool.get();
+		auto b = vdds::buffer_pool::from(h);
+		if (!b || b->size != 64 * 1024) {
+			hogl::post(area, area->ERROR, "invalid buffer");
+			return false;
+		}
+		fill(b, 0xaa);
+		if (!check(b, 0xaa))
+			return false;
+	}
+
+	// Small pool, no thread caches
+	return cycle_all(pool);
+}
+
+bool run_test()
+{
+	if (!run_fanout_test())
+		return false;
+
+	if (!run_handoff_test())
+		return false;
+
+	if (!run_hugepage_test())
+		return false;
+
+	return true;
+}
@@ -0,0 +1,166 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+#include "vdds/coro.hpp"
+
+#include <thread>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Coroutine pipeline test
+
+struct sample_msg : vdds::data64 {
+	static const char* data_type;
+
+	uint64_t& value() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* sample_msg::data_type = "vdds.test.sample";
+
+struct other_msg : vdds::data64 {
+	static const char* data_type;
+};
+const char* other_msg::data_type = "vdds.test.other";
+
+static const unsigned int n_msgs = 10000;
+
+// Fusion stage: pairs up the inputs and publishes the sum
+static vdds::coro::task fusion(vdds::sub<sample_msg>& left, vdds::sub<sample_msg>& right, vdds::pub<sample_msg>& out)
+{
+	for (unsigned int i=0; i<n_msgs; i++) {
+		sample_msg l = co_await left.next();
+		sample_msg r = co_await right.next();
+
+		sample_msg m;
+		m.timestamp = l.timestamp;
+		m.value() = l.value() + r.value();
+		out.push(m);
+	}
+}
+
+// Sink stage: validates the fused data
+static vdds::coro::task sink(vdds::sub<sample_msg>& in, vdds::coro::scheduler& sched, bool& failed)
+{
+	for (unsigned int i=0; i<n_msgs; i++) {
+		sample_msg m = co_await in.next();
+		if (m.timestamp != i || m.value() != 3 * i) {
+			hogl::post(area, area->ERROR, "invalid data: timestamp %llu value %llu expected %u", m.timestamp, m.value(), i);
+			failed = true;
+		}
+	}
+	sched.stop();
+}
+
+bool run_test()
+{
+	// Empty scheduler is rejected
+	try {
+		vdds::coro::scheduler s0(0);
+		hogl::post(area, area->ERROR, "scheduler with zero capacity created");
+		return false;
+	} catch (const std::invalid_argument&) {}
+
+	vdds::domain vd("DEFAULT");
+
+	// Scheduler capacity is the number of subscribers, stop() does not take a slot.
+	// Subscribers return their slot on destruction and on failed subscribe.
+	// Subscribers that are not attached to a scheduler can't be awaited.
+	{
+		vdds::coro::scheduler s1(1);
+		{
+			vdds::sub<sample_msg> sub0(vd, "sub0", "/test/attach", s1);
+			try {
+				vdds::sub<sample_msg> sub1(vd, "sub1", "/test/attach", s1);
+				hogl::post(area, area->ERROR, "subscriber attached to the full scheduler");
+				return false;
+			} catch (const std::length_error&) {}
+		}
+
+		// Data type mismatch
+		try {
+			vdds::sub<other_msg> sub1(vd, "sub1", "/test/attach", s1);
+			hogl::post(area, area->ERROR, "subscriber with mismatched data type created");
+			return false;
+		} catch (const std::logic_error&) {}
+
+		vdds::sub<sample_msg> sub0(vd, "sub0", "/test/attach", s1);
+
+		vdds::sub<sample_msg> sub2(vd, "sub2", "/test/attach");
+		try {
+			sub2.next();
+			hogl::post(area, area->ERROR, "awaiting subscriber without scheduler");
+			return false;
+		} catch (const std::logic_error&) {}
+
+		s1.stop();
+		s1.run();
+	}
+
+	vdds::coro::scheduler sched;
+
+	// Reliable input queues, the stages must see all data
+	vdds::sub_qos qos;
+	qos.reliability = vdds::sub_qos::reliability_policy::reliable;
+	qos.wait = vdds::sub_qos::backpressure::yield;
+	qos.max_blocking = std::chrono::seconds(1);
+
+	vdds::sub<sample_msg> left(vd, "fusion", "/test/left", sched, 64, qos);
+	vdds::sub<sample_msg> right(vd, "fusion", "/test/right", sched, 64, qos);
+
+	// Both stages run on the same thread, the fusion stage must not block on the sink
+	vdds::sub<sample_msg> fused(vd, "sink", "/test/fused", sched, n_msgs);
+	vdds::pub<sample_msg> out(vd, "fusion", "/test/fused");
+
+	bool failed = false;
+	fusion(left, right, out);
+	sink(fused, sched, failed);
+
+	std::thread pthread([&]() {
+		vdds::pub<sample_msg> pl(vd, "source", "/test/left");
+		vdds::pub<sample_msg> pr(vd, "source", "/test/right");
+		for (unsigned int i=0; i<n_msgs; i++) {
+			sample_msg m; m.timestamp = i;
+			m.value() = i;     pl.push(m);
+			m.value() = 2 * i; pr.push(m);
+		}
+	});
+
+	// Both stages run on this thread
+	sched.run();
+	pthread.join();
+
+	vd.dump();
+
+	return !failed;
+}
@@ -0,0 +1,258 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Durable (transient-local) topic test
+
+struct dur_msg : vdds::data {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+	uint64_t  count() const { return *reinterpret_cast<const uint64_t*>(&this->plain); }
+};
+const char* dur_msg::data_type = "vdds.test.durable";
+
+// Late joiners get the last samples
+static bool run_basic_test(const char* mode_name, vdds::topic_qos tqos, const vdds::sub_qos& sqos)
+{
+	hogl::post(area, area->INFO, "basic test: %s", mode_name);
+
+	vdds::domain vd("DEFAULT");
+
+	tqos.durability_depth = 4;
+	vd.create_topic("/test/durable", dur_msg::data_type, tqos);
+
+	vdds::pub<dur_msg> pub0(vd, "pub0", "/test/durable");
+	for (unsigned int i=0; i<10; i++) {
+		dur_msg m; m.count() = i;
+		pub0.push(m);
+	}
+
+	vdds::sub<dur_msg> sub0(vd, "sub0", "/test/durable", 8, nullptr, sqos);
+	vdds::sub<dur_msg> sub1(vd, "sub1", "/test/durable", 2, nullptr, sqos);
+
+	dur_msg m; m.count() = 10;
+	pub0.push(m);
+
+	// sub0: last 4 samples + new one, sub1: newest samples that fit
+	const uint64_t exp0[] = { 6, 7, 8, 9, 10 };
+	for (auto e : exp0) {
+		if (!sub0.pop(m) || m.seqno != e || m.count() != e) {
+			hogl::post(area, area->ERROR, "%s: sub0 unexpected seqno %llu expected %llu", mode_name, m.seqno, e);
+			return false;
+		}
+	}
+
+	// sub1 expectations (first, last):
+	//   drop_newest queues keep the preloaded samples, new data is dropped
+	//   lanes queues get the history in the shared lane and new data in the publisher lane
+	//   keep_last queues overwrite the oldest preloaded sample
+	//   ring subscribers read the ring directly (not limited by qsize)
+	uint64_t first = 8, last = 9;
+	if (sqos.multi_pub == vdds::sub_qos::mpub::lanes) last = 10;
+	if (sqos.history == vdds::sub_qos::history_policy::keep_last) { first = 9; last = 10; }
+	if (tqos.ring_depth) { first = 6; last = 10; }
+
+	uint64_t e1 = first;
+	while (sub1.pop(m)) {
+		if (m.seqno != e1) {
+			hogl::post(area, area->ERROR, "%s: sub1 unexpected seqno %llu expected %llu", mode_name, m.seqno, e1);
+			return false;
+		}
+		e1++;
+	}
+	if (e1 != last + 1) {
+		hogl::post(area, area->ERROR, "%s: sub1 missing data (next %llu)", mode_name, e1);
+		return false;
+	}
+
+	vd.dump();
+	return true;
+}
+
+// Subscribers join while data is being published.
+// Each subscriber must see a contiguous sequence (preload is atomic with registration).
+static bool run_join_test()
+{
+	hogl::post(area, area->INFO, "join test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::topic_qos tqos;
+	tqos.durability_depth = 16;
+	vd.create_topic("/test/durable", dur_msg::data_type, tqos);
+
+	static const unsigned int n_msgs = 20000;
+	static const unsigned int n_subs = 8;
+
+	std::atomic_bool done(false);
+	std::thread pthread([&]() {
+		vdds::pub<dur_msg> p(vd, "pub0", "/test/durable");
+		for (unsigned int n=0; n<n_msgs; n++) {
+			dur_msg m;
+			p.push(m);
+			if (!(n % 64)) std::this_thread::yield();
+		}
+		done = true;
+	});
+
+	std::vector<std::unique_ptr<vdds::sub<dur_msg>>> subs;
+	while (!done && subs.size() < n_subs) {
+		subs.push_back(std::make_unique<vdds::sub<dur_msg>>(vd, fmt::format("sub{}", subs.size()), "/test/durable", n_msgs));
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+
+	pthread.join();
+
+	for (auto &s : subs) {
+		dur_msg m;
+		if (!s->pop(m)) continue;
+		uint64_t next = m.seqno + 1;
+		while (s->pop(m)) {
+			if (m.seqno != next) {
+				hogl::post(area, area->ERROR, "%s: gap or duplicate seqno %llu expected %llu", s->name(), m.seqno, next);
+				return false;
+			}
+			next++;
+		}
+		if (next != n_msgs) {
+			hogl::post(area, area->ERROR, "%s: missing data, last seqno %llu", s->name(), next - 1);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Publisher blocked by the reliable subscriber must not stall the other publishers
+// and the new subscribers (the durable lock is not held across the fan-out).
+static bool run_stall_test()
+{
+	hogl::post(area, area->INFO, "stall test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::topic_qos tqos;
+	tqos.durability_depth = 4;
+	vd.create_topic("/test/durable", dur_msg::data_type, tqos);
+
+	vdds::sub_qos sqos;
+	sqos.reliability  = vdds::sub_qos::reliability_policy::reliable;
+	sqos.max_blocking = std::chrono::seconds(2);
+
+	// Reliable subscriber takes pub0 data only (count < 100)
+	vdds::sub<dur_msg> sub0(vd, "sub0", "/test/durable",
+			[](const dur_msg& m) { return m.count() < 100; }, 1, nullptr, sqos);
+	vdds::pub<dur_msg> pub1(vd, "pub1", "/test/durable");
+
+	// Second push blocks waiting for room in sub0
+	std::atomic_bool done(false);
+	std::thread pthread([&]() {
+		vdds::pub<dur_msg> p(vd, "pub0", "/test/durable");
+		for (unsigned int n=0; n<2; n++) {
+			dur_msg m; m.count() = n;
+			p.push(m);
+		}
+		done = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	// Best-effort subscriber joins and another publisher pushes while pub0 is blocked
+	auto t0 = std::chrono::steady_clock::now();
+	vdds::sub<dur_msg> sub1(vd, "sub1", "/test/durable", 8);
+	dur_msg m; m.count() = 100;
+	pub1.push(m);
+	auto dt = std::chrono::steady_clock::now() - t0;
+
+	bool blocked = !done;
+
+	while (sub0.pop(m));
+	pthread.join();
+
+	if (!blocked || dt >= sqos.max_blocking / 2) {
+		hogl::post(area, area->ERROR, "stall test: subscribe and push stalled by the blocked publisher (blocked %u dt %llu usec)",
+				blocked, std::chrono::duration_cast<std::chrono::microseconds>(dt).count());
+		return false;
+	}
+
+	// sub1 got the history and the live sample
+	unsigned int n = 0;
+	while (sub1.pop(m)) n++;
+	if (n < 2) {
+		hogl::post(area, area->ERROR, "stall test: sub1 missing data (got %u)", n);
+		return false;
+	}
+
+	return true;
+}
+
+bool run_test()
+{
+	vdds::topic_qos tqos;
+	vdds::sub_qos   sqos;
+
+	if (!run_basic_test("fifo", tqos, sqos))
+		return false;
+
+	sqos.multi_pub = vdds::sub_qos::mpub::lanes;
+	if (!run_basic_test("lanes", tqos, sqos))
+		return false;
+
+	sqos = vdds::sub_qos();
+	sqos.history = vdds::sub_qos::history_policy::keep_last;
+	if (!run_basic_test("keep-last", tqos, sqos))
+		return false;
+
+	sqos = vdds::sub_qos();
+	tqos.pool_size = 32;
+	if (!run_basic_test("pool", tqos, sqos))
+		return false;
+
+	tqos.pool_size  = 0;
+	tqos.ring_depth = 32;
+	if (!run_basic_test("ring", tqos, sqos))
+		return false;
+
+	if (!run_join_test())
+		return false;
+
+	if (!run_stall_test())
+		return false;
+
+	return true;
+}
@@ -0,0 +1,205 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Epoch based reclamation test
+
+struct epoch_msg : vdds::data {
+	static const char* data_type;
+};
+const char* epoch_msg::data_type = "vdds.test.epoch";
+
+using vdds::detail::epoch;
+
+static std::atomic<unsigned int> n_freed(0);
+
+struct tracked {
+	~tracked() { n_freed++; }
+};
+
+// Retired objects are not freed while readers are in the critical section
+static bool run_basic_test()
+{
+	hogl::post(area, area->INFO, "basic test");
+
+	epoch::synchronize();
+	n_freed = 0;
+
+	std::atomic_bool entered(false), release(false);
+	std::thread reader([&]() {
+		epoch::guard g;
+		entered = true;
+		while (!release) std::this_thread::yield();
+	});
+	while (!entered) std::this_thread::yield();
+
+	epoch::retire(new tracked());
+	epoch::retire(new tracked());
+	epoch::collect();
+	if (n_freed != 0 || epoch::pending() < 2) {
+		hogl::post(area, area->ERROR, "objects freed under active reader: freed %u pending %u",
+				(unsigned) n_freed, epoch::pending());
+		release = true; reader.join();
+		return false;
+	}
+
+	// Nested sections on the same thread don't block reclamation by others
+	{
+		epoch::guard g0;
+		epoch::guard g1;
+	}
+
+	release = true;
+	reader.join();
+
+	epoch::collect();
+	if (n_freed != 2) {
+		hogl::post(area, area->ERROR, "retired objects not freed: freed %u", (unsigned) n_freed);
+		return false;
+	}
+	return true;
+}
+
+// Subscribers and publishers come and go while data is being published
+static bool run_churn_test()
+{
+	hogl::post(area, area->INFO, "churn test");
+
+	vdds::domain vd("DEFAULT");
+
+	static const unsigned int n_pubs = 3;
+
+	std::atomic_bool done(false);
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int i=0; i<n_pubs; i++) {
+		pthreads.push_back(std::thread([&, i]() {
+			vdds::pub<epoch_msg> p(vd, fmt::format("pub{}", i), "/test/epoch");
+			while (!done) {
+				epoch_msg m;
+				p.push(m);
+			}
+		}));
+	}
+
+	auto t0 = std::chrono::steady_clock::now();
+	unsigned int n = 0;
+	while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(500)) {
+		vdds::notifier_cv nf;
+		vdds::sub<epoch_msg> s(vd, fmt::format("sub{}", n), "/test/epoch", 4, &nf);
+		vdds::pub<epoch_msg> p(vd, fmt::format("xpub{}", n), "/test/epoch");
+		epoch_msg m;
+		s.pop(m);
+		n++;
+	}
+
+	done = true;
+	for (auto &t : pthreads) t.join();
+
+	epoch::synchronize();
+
+	hogl::post(area, area->INFO, "%u iterations, %u pending objects", n, epoch::pending());
+
+	if (epoch::pending()) {
+		hogl::post(area, area->ERROR, "retired objects not freed: pending %u", epoch::pending());
+		return false;
+	}
+
+	return true;
+}
+
+// Publisher blocked on a reliable subscriber does not hold up unsubscribe and reclamation
+static bool run_blocked_test()
+{
+	hogl::post(area, area->INFO, "blocked test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::sub_qos qos;
+	qos.reliability  = vdds::sub_qos::reliability_policy::reliable;
+	qos.wait         = vdds::sub_qos::backpressure::wait;
+	qos.max_blocking = std::chrono::seconds(2);
+
+	vdds::sub<epoch_msg> sub0(vd, "sub0", "/test/epoch-blocked", 1, nullptr, qos);
+	vdds::pub<epoch_msg> pub0(vd, "pub0", "/test/epoch-blocked");
+
+	epoch_msg m;
+	pub0.push(m);
+
+	// Queue is full, the publisher blocks until the data is popped
+	std::atomic_bool pushed(false);
+	std::thread pthread([&]() {
+		epoch_msg m;
+		pub0.push(m);
+		pushed = true;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+	for (unsigned int i=0; i<16; i++) {
+		vdds::notifier_cv nf;
+		vdds::sub<epoch_msg> s(vd, fmt::format("sub{}", i + 1), "/test/epoch-blocked", 4, &nf);
+	}
+	epoch::collect();
+
+	bool blocked = !pushed;
+	size_t pending = epoch::pending();
+
+	sub0.pop(m);
+	pthread.join();
+
+	if (!blocked || pending) {
+		hogl::post(area, area->ERROR, "unsubscribe or reclamation waited for the publisher: blocked %u pending %u",
+				blocked, pending);
+		return false;
+	}
+
+	return true;
+}
+
+bool run_test()
+{
+	if (!run_basic_test())
+		return false;
+
+	if (!run_churn_test())
+		return false;
+
+	if (!run_blocked_test())
+		return false;
+
+	return true;
+}
@@ -0,0 +1,219 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+#include "vdds/executor.hpp"
+
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Callback executor test
+
+struct work_msg : vdds::data64 {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+	uint64_t count() const { return *reinterpret_cast<const uint64_t*>(&this->plain); }
+};
+const char* work_msg::data_type = "vdds.test.work";
+
+static const unsigned int n_topics  = 48;
+static const unsigned int n_pubs    = 2;
+static const unsigned int n_msgs    = 20000; // per publisher
+static const unsigned int n_workers = 4;
+
+// Per-subscription state, callbacks of the same subscription must be serialized
+struct alignas(64) sub_state {
+	std::atomic<bool>     busy{false};
+	std::atomic<uint64_t> count{0};
+	uint64_t last[n_pubs] = {};
+	bool ordered = true;
+};
+
+// Default number of workers is clamped to the supported range,
+// explicit values out of range are rejected.
+static bool run_threads_test()
+{
+	{
+		vdds::executor ex;
+		if (!ex.size() || ex.size() > vdds::executor::max_workers) {
+			hogl::post(area, area->ERROR, "unexpected default number of workers %u", ex.size());
+			return false;
+		}
+	}
+
+	try {
+		vdds::executor ex(vdds::executor::max_workers + 1);
+		hogl::post(area, area->ERROR, "executor with too many threads created");
+		return false;
+	} catch (const std::invalid_argument&) {}
+
+	return true;
+}
+
+// Destroyed subscription handles unsubscribe, the callbacks are not run anymore
+static bool run_remove_test()
+{
+	vdds::domain vd("DEFAULT");
+	std::atomic<uint64_t> count(0);
+	std::atomic<bool> removed(false), failed(false);
+
+	vdds::executor ex(2);
+	vdds::pub<work_msg> pub0(vd, "pub0", "/test/remove");
+
+	auto cb = [&](const work_msg&) {
+		if (removed) failed = true;
+		count++;
+	};
+
+	std::atomic<bool> stop(false);
+	std::thread pt([&]() {
+		work_msg m;
+		while (!stop) { pub0.push(m); std::this_thread::yield(); }
+	});
+
+	for (unsigned int i=0; i<64; i++) {
+		auto s = ex.subscribe<work_msg>(vd, "sub0", "/test/remove", cb);
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+		s.reset();
+		removed = true;
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+		removed = false;
+	}
+
+	stop = true;
+	pt.join();
+
+	// Subscriber constructor failures (data type mismatch) do not leave the tasks behind
+	vd.create_topic("/test/other", "vdds.test.other");
+	try {
+		auto s = ex.subscribe<work_msg>(vd, "sub1", "/test/other", cb);
+		hogl::post(area, area->ERROR, "subscribed to the topic with another data type");
+		return false;
+	} catch (const std::logic_error&) {}
+
+	hogl::post(area, area->INFO, "remove test: processed %llu", count.load());
+
+	if (failed) {
+		hogl::post(area, area->ERROR, "callback of the removed subscription");
+		return false;
+	}
+	return true;
+}
+
+bool run_test()
+{
+	if (!run_threads_test() || !run_remove_test())
+		return false;
+
+	// Callback state is declared before the executor and outlives the subscriptions
+	vdds::domain vd("DEFAULT");
+	std::vector<sub_state> state(n_topics);
+	std::atomic_bool failed(false);
+
+	vdds::executor ex(n_workers);
+
+	std::vector<vdds::executor::subscription<work_msg>> subs;
+	for (unsigned int i=0; i<n_topics; i++) {
+		auto prio = static_cast<vdds::executor::priority>(i % 3);
+		auto& st = state[i];
+
+		auto s = ex.subscribe<work_msg>(vd, fmt::format("worker{}", i), fmt::format("/test/work/{}", i),
+			[&st, &failed](const work_msg& m) {
+				if (st.busy.exchange(true)) {
+					hogl::post(area, area->ERROR, "concurrent callbacks");
+					failed = true;
+				}
+
+				// Per-publisher order must be preserved (timestamp carries the publisher index)
+				unsigned int p = m.timestamp;
+				uint64_t c = m.count();
+				if (p >= n_pubs || (st.last[p] && c <= st.last[p])) st.ordered = false;
+				if (p < n_pubs) st.last[p] = c;
+
+				st.count.fetch_add(1, std::memory_order_relaxed);
+				st.busy.store(false);
+			}, prio, 256);
+		subs.push_back(std::move(s));
+	}
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int p=0; p<n_pubs; p++) {
+		pthreads.push_back(std::thread([&, p]() {
+			std::vector<std::unique_ptr<vdds::pub<work_msg>>> pubs;
+			for (unsigned int i=0; i<n_topics; i++)
+				pubs.emplace_back(new vdds::pub<work_msg>(vd, fmt::format("pub{}", p), fmt::format("/test/work/{}", i)));
+
+			for (unsigned int n=1; n<=n_msgs; n++) {
+				work_msg m; m.timestamp = p; m.count() = n;
+				pubs[(n * 5 + p) % n_topics]->push(m);
+				if (n % 64 == 0) std::this_thread::yield();
+			}
+		}));
+	}
+	for (auto &t : pthreads) t.join();
+
+	// Wait for the workers to catch up
+	auto total = [&]() {
+		uint64_t n = 0;
+		for (unsigned int i=0; i<n_topics; i++) n += state[i].count + subs[i]->queue()->drop_count();
+		return n;
+	};
+
+	auto t0 = std::chrono::steady_clock::now();
+	while (total() < n_pubs * n_msgs && std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10))
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	uint64_t processed = 0;
+	for (auto &st : state) {
+		processed += st.count;
+		if (!st.ordered) {
+			hogl::post(area, area->ERROR, "out of order data");
+			failed = true;
+		}
+	}
+
+	hogl::post(area, area->INFO, "processed %llu total %llu runs %llu steals %llu",
+		processed, total(), ex.run_count(), ex.steal_count());
+
+	if (total() != n_pubs * n_msgs) {
+		hogl::post(area, area->ERROR, "lost data: total %llu expected %u", total(), n_pubs * n_msgs);
+		failed = true;
+	}
+
+	return !failed;
+}
@@ -0,0 +1,211 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Content filter test
+
+struct filter_msg : vdds::data {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+	const uint64_t& count() const { return *reinterpret_cast<const uint64_t*>(&this->plain); }
+};
+const char* filter_msg::data_type = "vdds.test.filter";
+
+// Push single entries and a batch, the filter accepts even counts only
+static bool run_mode_test(const std::string& mode, const vdds::topic_qos& tqos, vdds::sub_qos qos)
+{
+	hogl::post(area, area->INFO, "mode %s", mode);
+
+	vdds::domain vd("DEFAULT");
+	vd.create_topic("/test/filter", filter_msg::data_type, tqos);
+
+	vdds::sub<filter_msg> sub0(vd, "sub0", "/test/filter",
+			[](const filter_msg& m) { return m.count() % 2 == 0; }, 16, nullptr, qos);
+	vdds::sub<filter_msg> sub1(vd, "sub1", "/test/filter", 16, nullptr, qos);
+	vdds::pub<filter_msg> pub0(vd, "pub0", "/test/filter");
+
+	for (unsigned int i=0; i<8; i++) {
+		filter_msg m; m.count() = i;
+		pub0.push(m);
+	}
+
+	filter_msg b[8];
+	for (unsigned int i=0; i<8; i++) b[i].count() = 8 + i;
+	pub0.push_batch(b, 8);
+
+	filter_msg m;
+	for (unsigned int i=0; i<8; i++) {
+		if (!sub0.pop(m) || m.count() != i * 2) {
+			hogl::post(area, area->ERROR, "%s sub0: unexpected count %llu at %u", mode, m.count(), i);
+			return false;
+		}
+	}
+	if (sub0.pop(m)) {
+		hogl::post(area, area->ERROR, "%s sub0: unexpected data", mode);
+		return false;
+	}
+
+	unsigned int n1 = 0;
+	while (sub1.pop(m)) n1++;
+	if (n1 != 16) {
+		hogl::post(area, area->ERROR, "%s sub1: popped %u", mode, n1);
+		return false;
+	}
+
+	vdds::query::domain_info di;
+	vd.query(di);
+
+	auto& si0 = di.topics[0].subs[0];
+	auto& si1 = di.topics[0].subs[1];
+	if (si0.filter_count != 8 || si0.drop_count != 0 || si1.filter_count != 0) {
+		hogl::post(area, area->ERROR, "%s unexpected stats: sub0 %u/%u sub1 %u", mode,
+			si0.filter_count, si0.drop_count, si1.filter_count);
+		return false;
+	}
+
+	// Rejected data takes no queue slots
+	if (!tqos.ring_depth && si0.push_count != 8) {
+		hogl::post(area, area->ERROR, "%s sub0: push count %u", mode, si0.push_count);
+		return false;
+	}
+
+	vd.dump();
+	return true;
+}
+
+// Every Nth and min interval policies, single entries and batches
+static bool run_decimate_test(const std::string& mode, const vdds::topic_qos& tqos)
+{
+	hogl::post(area, area->INFO, "decimate %s", mode);
+
+	vdds::domain vd("DEFAULT");
+	vd.create_topic("/test/decimate", filter_msg::data_type, tqos);
+
+	vdds::sub_qos q0;
+	q0.decimation = 4;
+	vdds::sub_qos q1;
+	q1.min_interval = std::chrono::nanoseconds(10);
+
+	// Decimation applies to the data accepted by the content filter
+	vdds::sub_qos q2;
+	q2.decimation = 2;
+
+	vdds::sub<filter_msg> sub0(vd, "sub0", "/test/decimate", 32, nullptr, q0);
+	vdds::sub<filter_msg> sub1(vd, "sub1", "/test/decimate", 32, nullptr, q1);
+	vdds::sub<filter_msg> sub2(vd, "sub2", "/test/decimate",
+			[](const filter_msg& m) { return m.count() % 2 == 0; }, 32, nullptr, q2);
+	vdds::pub<filter_msg> pub0(vd, "pub0", "/test/decimate");
+
+	// Timestamps are 3ns apart
+	for (unsigned int i=0; i<16; i++) {
+		filter_msg m; m.count() = i; m.timestamp = i * 3;
+		pub0.push(m);
+	}
+
+	filter_msg b[16];
+	for (unsigned int i=0; i<16; i++) { b[i].count() = 16 + i; b[i].timestamp = (16 + i) * 3; }
+	pub0.push_batch(b, 16);
+
+	auto check = [&](vdds::sub<filter_msg>& s, unsigned int step) {
+		filter_msg m;
+		unsigned int n = 0;
+		for (; s.pop(m); n++) {
+			if (m.count() != n * step) {
+				hogl::post(area, area->ERROR, "%s %s: unexpected count %llu at %u", mode, s.name(), m.count(), n);
+				return false;
+			}
+		}
+		if (n != 32 / step || s.queue()->decimate_count() != 32 - n - s.queue()->filter_count()) {
+			hogl::post(area, area->ERROR, "%s %s: popped %u decimated %u", mode, s.name(), n, s.queue()->decimate_count());
+			return false;
+		}
+		return true;
+	};
+
+	// Every 4th: 0, 4, 8, ... Min interval 10ns: 0, 12, 24, ... Even and every 2nd: 0, 4, 8, ...
+	if (!check(sub0, 4) || !check(sub1, 4) || !check(sub2, 4))
+		return false;
+
+	vd.dump();
+	return true;
+}
+
+bool run_test()
+{
+	vdds::topic_qos tqos;
+	vdds::sub_qos qos;
+
+	if (!run_mode_test("fifo", tqos, qos))
+		return false;
+
+	qos.multi_pub = vdds::sub_qos::mpub::lockfree;
+	if (!run_mode_test("mpsc", tqos, qos))
+		return false;
+
+	qos.multi_pub = vdds::sub_qos::mpub::lanes;
+	if (!run_mode_test("lanes", tqos, qos))
+		return false;
+
+	qos = vdds::sub_qos();
+	qos.history = vdds::sub_qos::history_policy::keep_last;
+	if (!run_mode_test("keep_last", tqos, qos))
+		return false;
+
+	qos = vdds::sub_qos();
+	qos.reliability = vdds::sub_qos::reliability_policy::reliable;
+	if (!run_mode_test("reliable", tqos, qos))
+		return false;
+
+	qos = vdds::sub_qos();
+	tqos.pool_size = 64;
+	if (!run_mode_test("pool", tqos, qos))
+		return false;
+
+	tqos = vdds::topic_qos();
+	tqos.ring_depth = 32;
+	if (!run_mode_test("ring", tqos, qos))
+		return false;
+
+	if (!run_decimate_test("ring", tqos))
+		return false;
+
+	if (!run_decimate_test("fifo", vdds::topic_qos()))
+		return false;
+
+	return true;
+}
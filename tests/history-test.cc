@@ -0,0 +1,204 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Keep-last history test
+
+struct hist_msg : vdds::data {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* hist_msg::data_type = "vdds.test.history";
+
+static bool run_basic_test()
+{
+	hogl::post(area, area->INFO, "basic test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::sub_qos qos;
+	qos.history = vdds::sub_qos::history_policy::keep_last;
+
+	vdds::sub<hist_msg> sub0(vd, "sub0", "/test/history", 4, nullptr, qos);
+	vdds::sub<hist_msg> sub1(vd, "sub1", "/test/history", 4);
+	vdds::pub<hist_msg> pub0(vd, "pub0", "/test/history");
+
+	for (unsigned int i=0; i<10; i++) {
+		hist_msg m; m.count() = i;
+		pub0.push(m);
+	}
+
+	// Idle keep_last subscriber reports the overwrites before popping
+	{
+		vdds::query::domain_info di;
+		vd.query(di);
+		auto& si0 = di.topics[0].subs[0];
+		if (si0.overwrite_count != 6) {
+			hogl::post(area, area->ERROR, "sub0: unexpected overwrite count %u before pop", si0.overwrite_count);
+			return false;
+		}
+	}
+
+	// keep_last: freshest entries, drop_newest: oldest entries
+	hist_msg m;
+	for (unsigned int i=0; i<4; i++) {
+		if (!sub0.pop(m) || m.seqno != 6 + i || m.count() != 6 + i) {
+			hogl::post(area, area->ERROR, "sub0: unexpected seqno %llu at %u", m.seqno, i);
+			return false;
+		}
+		if (!sub1.pop(m) || m.seqno != i) {
+			hogl::post(area, area->ERROR, "sub1: unexpected seqno %llu at %u", m.seqno, i);
+			return false;
+		}
+	}
+	if (sub0.pop(m) || sub1.pop(m)) {
+		hogl::post(area, area->ERROR, "unexpected data");
+		return false;
+	}
+
+	vdds::query::domain_info di;
+	vd.query(di);
+
+	auto& si0 = di.topics[0].subs[0];
+	auto& si1 = di.topics[0].subs[1];
+	if (si0.push_count != 10 || si0.drop_count != 0 || si0.overwrite_count != 6 ||
+			si1.drop_count != 6 || si1.overwrite_count != 0) {
+		hogl::post(area, area->ERROR, "unexpected stats: sub0 %u/%u/%u sub1 %u/%u",
+			si0.push_count, si0.drop_count, si0.overwrite_count, si1.drop_count, si1.overwrite_count);
+		return false;
+	}
+
+	// Sample pool topics don't support keep_last
+	vdds::topic_qos tqos;
+	tqos.pool_size = 8;
+	vd.create_topic("/test/history-pool", hist_msg::data_type, tqos);
+	try {
+		vdds::sub<hist_msg> sub2(vd, "sub2", "/test/history-pool", 4, nullptr, qos);
+		hogl::post(area, area->ERROR, "keep_last subscribed to pooled topic");
+		return false;
+	} catch (const std::logic_error&) {}
+
+	// Nor do broadcast ring topics (ring subscribers always read the ring)
+	tqos = vdds::topic_qos();
+	tqos.ring_depth = 8;
+	vd.create_topic("/test/history-ring", hist_msg::data_type, tqos);
+	try {
+		vdds::sub<hist_msg> sub3(vd, "sub3", "/test/history-ring", 4, nullptr, qos);
+		hogl::post(area, area->ERROR, "keep_last subscribed to ring topic");
+		return false;
+	} catch (const std::logic_error&) {}
+
+	vd.dump();
+	return true;
+}
+
+// Multiple publishers, slow subscriber
+static bool run_stress_test()
+{
+	hogl::post(area, area->INFO, "stress test");
+
+	vdds::domain vd("DEFAULT");
+
+	static const unsigned int n_pubs = 3;
+	static const unsigned int n_msgs = 100000;
+
+	vdds::sub_qos qos;
+	qos.history = vdds::sub_qos::history_policy::keep_last;
+
+	vdds::notifier_cv nf;
+	vdds::sub<hist_msg> sub0(vd, "sub0", "/test/history", 16, &nf, qos);
+
+	std::atomic_bool failed(false);
+	std::atomic_bool done(false);
+
+	uint64_t popped = 0;
+	std::thread sthread([&]() {
+		std::vector<uint64_t> next(n_pubs, 0);
+		auto drain = [&]() {
+			hist_msg m;
+			while (sub0.pop(m)) {
+				uint64_t pid = m.timestamp;
+				if (pid >= n_pubs || m.count() < next[pid]) {
+					hogl::post(area, area->ERROR, "out of order data pub %llu count %llu", pid, m.count());
+					failed = true;
+				} else
+					next[pid] = m.count() + 1;
+				popped++;
+			}
+		};
+		while (!done) {
+			nf.wait_for(std::chrono::milliseconds(1));
+			drain();
+		}
+		drain();
+	});
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int i=0; i<n_pubs; i++) {
+		pthreads.push_back(std::thread([&, i]() {
+			vdds::pub<hist_msg> p(vd, fmt::format("pub{}", i), "/test/history");
+			for (unsigned int n=0; n<n_msgs; n++) {
+				hist_msg m; m.timestamp = i; m.count() = n;
+				p.push(m);
+			}
+		}));
+	}
+
+	for (auto &t : pthreads) t.join();
+	done = true;
+	sthread.join();
+
+	auto q = sub0.queue();
+	if (popped + q->overwrite_count() != n_pubs * n_msgs || q->drop_count() != 0) {
+		hogl::post(area, area->ERROR, "popped %llu overwrites %u drops %u", popped, q->overwrite_count(), q->drop_count());
+		failed = true;
+	}
+
+	return !failed;
+}
+
+bool run_test()
+{
+	if (!run_basic_test())
+		return false;
+
+	if (!run_stress_test())
+		return false;
+
+	return true;
+}
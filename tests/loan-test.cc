@@ -0,0 +1,193 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Zero-copy (loaned sample) publishing test
+
+struct frame_msg : vdds::data {
+	static const char* data_type;
+
+	struct payload_t {
+		uint64_t frame_id;
+		uint64_t exposure;
+	};
+
+	payload_t* payload() { return reinterpret_cast<payload_t*>(&this->plain); }
+	const payload_t* payload() const { return reinterpret_cast<const payload_t*>(&this->plain); }
+};
+const char* frame_msg::data_type = "vdds.test.frame";
+
+static const unsigned int n_samples = 8;
+static const unsigned int n_subs    = 16;
+
+// Pool size validation and accounting
+static bool run_pool_test()
+{
+	for (size_t n : { size_t(0), size_t(UINT32_MAX) }) {
+		try {
+			vdds::sample_pool p(n);
+			hogl::post(area, area->ERROR, "sample pool of size %llu created", (uint64_t) n);
+			return false;
+		} catch (const std::invalid_argument&) {}
+	}
+
+	vdds::sample_pool p(n_samples);
+	auto s = p.get();
+	if (!s || p.size() != n_samples || p.available() != n_samples - 1) {
+		hogl::post(area, area->ERROR, "unexpected pool size %u available %u", p.size(), p.available());
+		return false;
+	}
+
+	p.put(s);
+	if (p.available() != n_samples) {
+		hogl::post(area, area->ERROR, "sample not returned: available %u", p.available());
+		return false;
+	}
+	return true;
+}
+
+bool run_test()
+{
+	hogl::post(area, area->INFO, "Starting test");
+
+	if (!run_pool_test())
+		return false;
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::topic_qos qos;
+	qos.pool_size = n_samples;
+	vd.create_topic("/test/frame", frame_msg::data_type, qos);
+
+	vdds::pub<frame_msg> pub0(vd, "pub0", "/test/frame");
+
+	using frame_sub = vdds::sub<frame_msg>;
+	std::vector<std::unique_ptr<frame_sub>> subs;
+	for (unsigned int i=0; i<n_subs; i++)
+		subs.push_back( std::make_unique<frame_sub>(vd, fmt::format("sub{}", i), "/test/frame", 4) );
+
+	// Loan, fill in place, and commit
+	{
+		auto l = pub0.loan();
+		if (!l) {
+			hogl::post(area, area->ERROR, "loan failed");
+			return false;
+		}
+		l->timestamp = 1000;
+		l->payload()->frame_id = 1;
+		l.commit();
+
+		// Committed handle is invalid, second commit is a noop
+		l.commit();
+	}
+
+	// All subscribers must reference the same sample
+	{
+		std::vector<vdds::sample_ref<frame_msg>> refs(n_subs);
+		for (unsigned int i=0; i<n_subs; i++) {
+			if (!subs[i]->pop(refs[i])) {
+				hogl::post(area, area->ERROR, "sub%u: no data", i);
+				return false;
+			}
+			if (refs[i].get() != refs[0].get() || refs[i]->payload()->frame_id != 1) {
+				hogl::post(area, area->ERROR, "sub%u: sample missmatch", i);
+				return false;
+			}
+		}
+	}
+
+	// Exhaust the pool. All samples are back in the pool at this point.
+	{
+		std::vector<vdds::loaned<frame_msg>> loans;
+		for (unsigned int i=0; i<n_samples; i++) {
+			loans.push_back(pub0.loan());
+			if (!loans.back()) {
+				hogl::post(area, area->ERROR, "loan %u failed", i);
+				return false;
+			}
+		}
+
+		auto l = pub0.loan();
+		if (l) {
+			hogl::post(area, area->ERROR, "loan didn't fail on empty pool");
+			return false;
+		}
+
+		// Failed loan commits nothing
+		l.commit();
+
+		// Uncommitted loans are returned to the pool here
+	}
+
+	// Regular push on the pooled topic. Queues hold 4 entries, the rest is dropped,
+	// and all samples must be released after the subscribers pop everything.
+	for (unsigned int i=0; i<n_samples; i++) {
+		frame_msg m;
+		m.timestamp = 2000 + i;
+		m.payload()->frame_id = 100 + i;
+		pub0.push(m);
+	}
+
+	for (unsigned int i=0; i<n_subs; i++) {
+		frame_msg m;
+		unsigned int n = 0;
+		while (subs[i]->pop(m)) {
+			if (m.payload()->frame_id != 100 + n) {
+				hogl::post(area, area->ERROR, "sub%u: unexpected frame %llu", i, m.payload()->frame_id);
+				return false;
+			}
+			n++;
+		}
+		if (n != 4 || subs[i]->queue()->drop_count() != 4) {
+			hogl::post(area, area->ERROR, "sub%u: popped %u drops %u", i, n, subs[i]->queue()->drop_count());
+			return false;
+		}
+	}
+
+	std::vector<vdds::loaned<frame_msg>> loans;
+	for (unsigned int i=0; i<n_samples; i++) {
+		loans.push_back(pub0.loan());
+		if (!loans.back()) {
+			hogl::post(area, area->ERROR, "sample leak: loan %u failed", i);
+			return false;
+		}
+	}
+
+	vd.dump();
+
+	return true;
+}
@@ -0,0 +1,209 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Multi-publisher push test (mutex, lock-free and per-publisher lane subscriber queues)
+
+struct mpub_msg : vdds::data {
+	static const char* data_type;
+
+	struct payload_t {
+		uint64_t pub_id;
+		uint64_t count;
+	};
+
+	payload_t* payload() { return reinterpret_cast<payload_t*>(&this->plain); }
+	const payload_t* payload() const { return reinterpret_cast<const payload_t*>(&this->plain); }
+};
+const char* mpub_msg::data_type = "vdds.test.mpub";
+
+static const unsigned int n_pubs = 6;
+static const unsigned int n_msgs = 100000;
+
+static bool run_mpub_test(const vdds::sub_qos& qos, const char* mode_name)
+{
+	hogl::post(area, area->INFO, "multi-pub test: %s", mode_name);
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::notifier_cv nf;
+	vdds::sub<mpub_msg> sub(vd, "sub0", "/test/mpub", 256, &nf, qos);
+
+	std::atomic_bool failed(false);
+	std::atomic_bool done(false);
+
+	uint64_t popped = 0;
+	std::thread sthread([&]() {
+		std::vector<uint64_t> next(n_pubs, 0);
+		auto drain = [&]() {
+			mpub_msg m;
+			while (sub.pop(m)) {
+				auto p = m.payload();
+				// Per-publisher order must be preserved
+				if (p->pub_id >= n_pubs || p->count < next[p->pub_id]) {
+					hogl::post(area, area->ERROR, "pub%llu: out of order count %llu expected >= %llu",
+						p->pub_id, p->count, next[p->pub_id % n_pubs]);
+					failed = true;
+				} else
+					next[p->pub_id] = p->count + 1;
+				popped++;
+			}
+		};
+		while (!done) {
+			nf.wait_for(std::chrono::milliseconds(10));
+			drain();
+		}
+		drain();
+	});
+
+	std::vector<std::unique_ptr<vdds::pub<mpub_msg>>> pubs;
+	for (unsigned int i=0; i<n_pubs; i++)
+		pubs.push_back(std::make_unique<vdds::pub<mpub_msg>>(vd, fmt::format("pub{}", i), "/test/mpub"));
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int i=0; i<n_pubs; i++) {
+		pthreads.push_back(std::thread([&, i]() {
+			auto& p = *pubs[i];
+			for (unsigned int n=0; n<n_msgs; n++) {
+				mpub_msg m; m.timestamp = n;
+				m.payload()->pub_id = i;
+				m.payload()->count  = n;
+				p.push(m);
+			}
+		}));
+	}
+
+	for (auto &t : pthreads) t.join();
+	done = true;
+	sthread.join();
+
+	vd.dump();
+
+	auto q = sub.queue();
+	if (q->push_count() != n_pubs * n_msgs || popped + q->drop_count() != n_pubs * n_msgs) {
+		hogl::post(area, area->ERROR, "%s: push-count %u popped %llu drops %u expected total %u",
+				mode_name, q->push_count(), popped, q->drop_count(), n_pubs * n_msgs);
+		failed = true;
+	}
+
+	if (qos.multi_pub == vdds::sub_qos::mpub::lanes) {
+		vdds::query::domain_info di;
+		vdds::query::init(di, 1, 1, n_pubs);
+		vd.query(di, vdds::query::filter{"/test/mpub", "any"});
+
+		auto& si = di.topics[0].subs[0];
+		uint32_t lane_drops = 0;
+		for (auto n : si.lane_drop_count) lane_drops += n;
+		if (si.lane_drop_count.size() != qos.max_lanes || lane_drops != si.drop_count) {
+			hogl::post(area, area->ERROR, "%s: nlanes %u lane drops %u expected %u",
+					mode_name, si.lane_drop_count.size(), lane_drops, si.drop_count);
+			failed = true;
+		}
+	}
+
+	return !failed;
+}
+
+// Lane merge order
+static bool run_order_test()
+{
+	hogl::post(area, area->INFO, "lane order test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::sub_qos qos;
+	qos.multi_pub = vdds::sub_qos::mpub::lanes;
+
+	vdds::sub<mpub_msg> sub0(vd, "sub0", "/test/order", 8, nullptr, qos);
+	qos.order = vdds::sub_qos::lane_order::round_robin;
+	vdds::sub<mpub_msg> sub1(vd, "sub1", "/test/order", 8, nullptr, qos);
+
+	vdds::pub<mpub_msg> pub0(vd, "pub0", "/test/order");
+	vdds::pub<mpub_msg> pub1(vd, "pub1", "/test/order");
+
+	// pub0: seqno 0, 1, 2   pub1: seqno 3, 4, 5
+	for (auto p : { &pub0, &pub0, &pub0, &pub1, &pub1, &pub1 }) {
+		mpub_msg m; p->push(m);
+	}
+
+	const uint64_t seqno_order[] = { 0, 1, 2, 3, 4, 5 };
+	const uint64_t rr_order[]    = { 0, 3, 1, 4, 2, 5 };
+
+	mpub_msg m;
+	for (unsigned int i=0; i<6; i++) {
+		if (!sub0.pop(m) || m.seqno != seqno_order[i]) {
+			hogl::post(area, area->ERROR, "sub0: unexpected seqno %llu at %u", m.seqno, i);
+			return false;
+		}
+		if (!sub1.pop(m) || m.seqno != rr_order[i]) {
+			hogl::post(area, area->ERROR, "sub1: unexpected seqno %llu at %u", m.seqno, i);
+			return false;
+		}
+	}
+
+	return !sub0.pop(m) && !sub1.pop(m);
+}
+
+bool run_test()
+{
+	vdds::sub_qos qos;
+
+	qos.multi_pub = vdds::sub_qos::mpub::lock;
+	if (!run_mpub_test(qos, "lock"))
+		return false;
+
+	qos.multi_pub = vdds::sub_qos::mpub::lockfree;
+	if (!run_mpub_test(qos, "lockfree"))
+		return false;
+
+	// Dedicated lane per publisher
+	qos.multi_pub = vdds::sub_qos::mpub::lanes;
+	qos.max_lanes = n_pubs;
+	if (!run_mpub_test(qos, "lanes"))
+		return false;
+
+	// Some publishers share the last lane
+	qos.max_lanes = n_pubs / 2;
+	qos.order = vdds::sub_qos::lane_order::round_robin;
+	if (!run_mpub_test(qos, "shared-lanes"))
+		return false;
+
+	if (!run_order_test())
+		return false;
+
+	return true;
+}
@@ -0,0 +1,323 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <thread>
+#include <atomic>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Notifier semantics and wakeup test
+
+struct notify_msg : vdds::data64 {
+	static const char* data_type;
+};
+const char* notify_msg::data_type = "vdds.test.notify";
+
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+using std::chrono::duration_cast;
+
+static long elapsed_ms(steady_clock::time_point t0)
+{
+	return duration_cast<milliseconds>(steady_clock::now() - t0).count();
+}
+
+// Basic notifier semantics
+static bool run_wait_test(vdds::notifier& nf)
+{
+	const std::string& name = nf.name();
+
+	// Pending notification, returns right away
+	nf.notify();
+	auto t0 = steady_clock::now();
+	nf.wait_for(std::chrono::seconds(10));
+	if (elapsed_ms(t0) > 1000) {
+		hogl::post(area, area->ERROR, "%s: pending notification was lost", name);
+		return false;
+	}
+
+	// No notification, returns after the timeout
+	t0 = steady_clock::now();
+	nf.wait_for(milliseconds(20));
+	if (elapsed_ms(t0) < 19) {
+		hogl::post(area, area->ERROR, "%s: wait returned before the timeout (%ld msec)", name, elapsed_ms(t0));
+		return false;
+	}
+
+	// Notification from another thread wakes up the waiter
+	std::atomic_bool woken(false);
+	std::thread waiter([&]() {
+		nf.wait_for(std::chrono::seconds(10));
+		woken = true;
+	});
+	std::this_thread::sleep_for(milliseconds(20));
+	t0 = steady_clock::now();
+	nf.notify();
+	waiter.join();
+	if (!woken || elapsed_ms(t0) > 1000) {
+		hogl::post(area, area->ERROR, "%s: waiter was not woken up", name);
+		return false;
+	}
+
+	return true;
+}
+
+// Notifications must not be lost under load
+static bool run_flow_test(vdds::notifier& nf)
+{
+	static const unsigned int n_msgs = 100000;
+	const std::string& name = nf.name();
+
+	vdds::domain vd("DEFAULT");
+	vdds::pub<notify_msg> pub(vd, "pub0", "/test/notify");
+	vdds::sub<notify_msg> sub(vd, "sub0", "/test/notify", 1024, &nf);
+
+	auto t0 = steady_clock::now();
+
+	uint64_t popped = 0;
+	std::thread sthread([&]() {
+		notify_msg m;
+		while (popped + sub.queue()->drop_count() < n_msgs) {
+			// Long timeout, lost wakeups would stall the test
+			nf.wait_for(std::chrono::seconds(10));
+			while (sub.pop(m)) popped++;
+		}
+	});
+
+	for (unsigned int i=0; i<n_msgs; i++) {
+		notify_msg m; m.timestamp = i;
+		pub.push(m);
+		if (i % 256 == 0) std::this_thread::yield();
+	}
+
+	sthread.join();
+
+	hogl::post(area, area->INFO, "%s: popped %llu drops %u in %ld msec", name, popped, sub.queue()->drop_count(), elapsed_ms(t0));
+
+	if (elapsed_ms(t0) > 5000) {
+		hogl::post(area, area->ERROR, "%s: subscriber stalled", name);
+		return false;
+	}
+	return true;
+}
+
+// Shutdown overrides the wait timeout
+static bool run_shutdown_test(vdds::notifier& nf)
+{
+	nf.shutdown(milliseconds(1));
+
+	auto t0 = steady_clock::now();
+	for (unsigned int i=0; i<3; i++)
+		nf.wait_for(std::chrono::seconds(10));
+
+	if (elapsed_ms(t0) > 1000) {
+		hogl::post(area, area->ERROR, "%s: forced timeout is ignored", nf.name());
+		return false;
+	}
+	return true;
+}
+
+// Subscribers multiplexed with other fds in an epoll loop
+static bool run_epoll_test()
+{
+	static const unsigned int n_msgs = 10000;
+
+	hogl::post(area, area->INFO, "epoll test");
+
+	vdds::notifier_eventfd nf;
+
+	vdds::domain vd("DEFAULT");
+	vdds::pub<notify_msg> pub(vd, "pub0", "/test/notify");
+	vdds::sub<notify_msg> sub0(vd, "sub0", "/test/notify", 1024, &nf);
+	vdds::sub<notify_msg> sub1(vd, "sub1", "/test/notify", 1024, &nf);
+
+	// Burst of pushes is coalesced into a single eventfd write
+	for (unsigned int i=0; i<100; i++) {
+		notify_msg m; m.timestamp = i;
+		pub.push(m);
+	}
+
+	uint64_t v = 0;
+	if (read(nf.fd(), &v, sizeof(v)) != sizeof(v) || v != 1) {
+		hogl::post(area, area->ERROR, "burst was not coalesced, eventfd counter %llu", v);
+		return false;
+	}
+	nf.reset();
+	sub0.flush();
+	sub1.flush();
+
+	int pfd[2];
+	if (pipe(pfd) < 0)
+		return false;
+
+	int ep = epoll_create1(EPOLL_CLOEXEC);
+	struct epoll_event ev = {};
+	ev.events = EPOLLIN; ev.data.fd = nf.fd();
+	epoll_ctl(ep, EPOLL_CTL_ADD, nf.fd(), &ev);
+	ev.events = EPOLLIN; ev.data.fd = pfd[0];
+	epoll_ctl(ep, EPOLL_CTL_ADD, pfd[0], &ev);
+
+	std::thread pthread([&]() {
+		for (unsigned int i=0; i<n_msgs; i++) {
+			notify_msg m; m.timestamp = i;
+			pub.push(m);
+			if (i % 256 == 0) std::this_thread::yield();
+		}
+
+		// Other event source
+		char c = 'x';
+		ssize_t r = write(pfd[1], &c, 1);
+		(void) r;
+	});
+
+	uint64_t popped = 0;
+	bool pipe_event = false;
+	auto t0 = steady_clock::now();
+
+	auto drops = [&]() { return sub0.queue()->drop_count() + sub1.queue()->drop_count(); };
+	while ((popped + drops() < 2 * n_msgs || !pipe_event) && elapsed_ms(t0) < 5000) {
+		struct epoll_event events[2];
+		int n = epoll_wait(ep, events, 2, 100);
+		for (int i=0; i<n; i++) {
+			if (events[i].data.fd == pfd[0]) {
+				char c;
+				ssize_t r = read(pfd[0], &c, 1);
+				(void) r;
+				pipe_event = true;
+				continue;
+			}
+
+			nf.reset();
+			notify_msg m;
+			while (sub0.pop(m)) popped++;
+			while (sub1.pop(m)) popped++;
+		}
+	}
+
+	pthread.join();
+	close(ep);
+	close(pfd[0]);
+	close(pfd[1]);
+
+	hogl::post(area, area->INFO, "epoll: popped %llu drops %u pipe %u in %ld msec", popped, drops(), pipe_event, elapsed_ms(t0));
+
+	if (popped + drops() < 2 * n_msgs || !pipe_event) {
+		hogl::post(area, area->ERROR, "epoll loop missed events");
+		return false;
+	}
+	return true;
+}
+
+// Periodic topic with adaptive notifier
+static bool run_periodic_test()
+{
+	static const unsigned int n_msgs = 300;
+	static const auto period = std::chrono::milliseconds(1);
+
+	hogl::post(area, area->INFO, "periodic test");
+
+	vdds::notifier_adaptive nf(std::chrono::microseconds(100));
+
+	vdds::domain vd("DEFAULT");
+	vdds::pub<notify_msg> pub(vd, "pub0", "/test/periodic");
+	vdds::sub<notify_msg> sub(vd, "sub0", "/test/periodic", 16, &nf);
+
+	uint64_t popped = 0, total_lat = 0, max_lat = 0;
+	std::thread sthread([&]() {
+		notify_msg m;
+		while (popped < n_msgs) {
+			nf.wait_for(std::chrono::seconds(10));
+			while (sub.pop(m)) {
+				uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now().time_since_epoch()).count();
+				uint64_t lat = now - m.timestamp;
+				total_lat += lat;
+				max_lat = std::max(max_lat, lat);
+				popped++;
+			}
+		}
+	});
+
+	auto next = steady_clock::now();
+	for (unsigned int i=0; i<n_msgs; i++) {
+		next += period;
+		std::this_thread::sleep_until(next);
+
+		notify_msg m;
+		m.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		pub.push(m);
+	}
+
+	sthread.join();
+
+	hogl::post(area, area->INFO, "periodic: popped %llu interval %lld nsec avg-latency %llu nsec max-latency %llu nsec spin-hits %llu sleeps %llu",
+		popped, (long long) nf.interval().count(), total_lat / n_msgs, max_lat, nf.spin_hits(), nf.sleeps());
+
+	return popped == n_msgs;
+}
+
+template<typename N>
+static bool run_notifier_test()
+{
+	N nf;
+	hogl::post(area, area->INFO, "notifier test: %s", nf.name());
+	return run_wait_test(nf) && run_flow_test(nf) && run_shutdown_test(nf);
+}
+
+bool run_test()
+{
+	if (!run_notifier_test<vdds::notifier_cv>())
+		return false;
+
+	if (!run_notifier_test<vdds::notifier_futex>())
+		return false;
+
+	if (!run_notifier_test<vdds::notifier_eventfd>())
+		return false;
+
+	if (!run_epoll_test())
+		return false;
+
+	if (!run_notifier_test<vdds::notifier_adaptive>())
+		return false;
+
+	if (!run_periodic_test())
+		return false;
+
+	return true;
+}
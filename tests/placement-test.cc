@@ -0,0 +1,145 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include <thread>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Queue slot placement test
+
+struct frame_msg : vdds::data1k {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* frame_msg::data_type = "vdds.test.frame";
+
+static const unsigned int n_msgs = 10000;
+static const unsigned int qsize  = 4096;
+
+static bool run_placement_test(const std::string& mode, const vdds::topic_qos& tqos, vdds::sub_qos qos)
+{
+	hogl::post(area, area->INFO, "placement test: %s", mode);
+
+	vdds::domain vd("DEFAULT");
+	vd.create_topic<frame_msg::slot_type>("/test/frames", frame_msg::data_type, tqos);
+
+	vdds::pub<frame_msg> pub(vd, "pub0", "/test/frames");
+
+	bool failed = false;
+	bool local = qos.numa == vdds::sub_qos::numa_policy::local;
+
+	// Subscriber is created on the main thread, the local policy must pick the consumer's node
+	vdds::sub<frame_msg> sub(vd, "sub0", "/test/frames", qsize, nullptr, qos);
+	if (local && sub.queue()->node() != -1) {
+		hogl::post(area, area->ERROR, "%s: slots bound before the first pop (node %d)", mode, sub.queue()->node());
+		return false;
+	}
+
+	std::thread sthread([&]() {
+		uint64_t next = 0;
+		for (unsigned int i=0; i<n_msgs; i++) {
+			frame_msg m; m.count() = i;
+			pub.push(m);
+
+			// Drain every now and then, the queue must hold the bursts
+			if ((i + 1) % (qsize / 2) && i + 1 != n_msgs) continue;
+
+			while (sub.pop(m)) {
+				if (m.count() != next) {
+					hogl::post(area, area->ERROR, "%s: out of order count %llu expected %llu", mode, m.count(), next);
+					failed = true;
+				}
+				next = m.count() + 1;
+			}
+		}
+
+		if (next != n_msgs || sub.queue()->drop_count()) {
+			hogl::post(area, area->ERROR, "%s: received %llu drops %u", mode, next, sub.queue()->drop_count());
+			failed = true;
+		}
+
+		if (local && sub.queue()->node() < 0) {
+			hogl::post(area, area->ERROR, "%s: slots are not bound after the first pop", mode);
+			failed = true;
+		}
+		hogl::post(area, area->INFO, "%s: slots node %d consumer node %d", mode, sub.queue()->node(), vdds::detail::current_node());
+
+		vd.dump();
+	});
+	sthread.join();
+
+	return !failed;
+}
+
+bool run_test()
+{
+	hogl::post(area, area->INFO, "current node %d", vdds::detail::current_node());
+
+	vdds::topic_qos pool_tqos;
+	pool_tqos.pool_size = qsize * 2;
+
+	vdds::sub_qos local;
+	local.numa = vdds::sub_qos::numa_policy::local;
+
+	vdds::sub_qos node;
+	node.numa = vdds::sub_qos::numa_policy::node;
+	node.numa_node = vdds::detail::current_node();
+
+	// Explicit hugepages are typically not reserved, queues fall back to transparent hugepages
+	vdds::sub_qos huge = local;
+	huge.hugepages = true;
+
+	vdds::sub_qos lanes = huge;
+	lanes.multi_pub = vdds::sub_qos::mpub::lanes;
+
+	if (!run_placement_test("fifo-local", vdds::topic_qos(), local))
+		return false;
+
+	if (!run_placement_test("fifo-node", vdds::topic_qos(), node))
+		return false;
+
+	if (!run_placement_test("fifo-hugepages", vdds::topic_qos(), huge))
+		return false;
+
+	if (!run_placement_test("lanes-hugepages", vdds::topic_qos(), lanes))
+		return false;
+
+	if (!run_placement_test("pool-hugepages", pool_tqos, huge))
+		return false;
+
+	return true;
+}
@@ -0,0 +1,235 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Reliable subscriber test
+
+struct rel_msg : vdds::data {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+	uint64_t  count() const { return *reinterpret_cast<const uint64_t*>(&this->plain); }
+};
+const char* rel_msg::data_type = "vdds.test.reliable";
+
+// Publishers must not lose data because of a slow subscriber
+static bool run_lossless_test(const char* mode_name, vdds::sub_qos qos)
+{
+	hogl::post(area, area->INFO, "lossless test: %s", mode_name);
+
+	vdds::domain vd("DEFAULT");
+
+	static const unsigned int n_pubs = 2;
+	static const unsigned int n_msgs = 20000;
+
+	qos.reliability  = vdds::sub_qos::reliability_policy::reliable;
+	qos.max_blocking = std::chrono::seconds(5);
+
+	vdds::notifier_cv nf;
+	vdds::sub<rel_msg> sub0(vd, "sub0", "/test/reliable", 4, &nf, qos);
+
+	std::atomic_bool failed(false);
+	std::atomic_bool done(false);
+	std::atomic<unsigned int> timeouts(0);
+
+	uint64_t popped = 0;
+	std::thread sthread([&]() {
+		std::vector<uint64_t> next(n_pubs, 0);
+		auto check = [&](const rel_msg& m) {
+			uint64_t pid = m.timestamp;
+			if (pid >= n_pubs || m.count() != next[pid]) {
+				hogl::post(area, area->ERROR, "%s: lost or out of order data pub %llu count %llu", mode_name, pid, m.count());
+				failed = true;
+			} else
+				next[pid]++;
+			popped++;
+		};
+		auto drain = [&]() {
+			// Alternate between pop and drain, slow down once in a while
+			rel_msg m;
+			if (sub0.pop(m)) check(m);
+			sub0.drain(check, 2);
+			if ((popped & 0x3ff) == 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+		};
+		while (!done) {
+			nf.wait_for(std::chrono::milliseconds(1));
+			drain();
+		}
+		while (popped < n_pubs * n_msgs && !failed) drain();
+	});
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int i=0; i<n_pubs; i++) {
+		pthreads.push_back(std::thread([&, i]() {
+			vdds::pub<rel_msg> p(vd, fmt::format("pub{}", i), "/test/reliable");
+			for (unsigned int n=0; n<n_msgs; n++) {
+				rel_msg m; m.timestamp = i; m.count() = n;
+				timeouts += p.push(m);
+			}
+		}));
+	}
+
+	for (auto &t : pthreads) t.join();
+	done = true;
+	sthread.join();
+
+	auto q = sub0.queue();
+	if (timeouts || q->drop_count() || popped != n_pubs * n_msgs) {
+		hogl::post(area, area->ERROR, "%s: timeouts %u drops %u popped %llu", mode_name, (unsigned) timeouts, q->drop_count(), popped);
+		failed = true;
+	}
+
+	return !failed;
+}
+
+// Publishers give up after max blocking time
+static bool run_timeout_test()
+{
+	hogl::post(area, area->INFO, "timeout test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::sub_qos qos;
+	qos.reliability  = vdds::sub_qos::reliability_policy::reliable;
+	qos.max_blocking = std::chrono::milliseconds(5);
+
+	vdds::sub<rel_msg> sub0(vd, "sub0", "/test/reliable", 2, nullptr, qos);
+	vdds::sub<rel_msg> sub1(vd, "sub1", "/test/reliable", 2);
+	vdds::pub<rel_msg> pub0(vd, "pub0", "/test/reliable");
+
+	rel_msg m;
+	std::vector<const vdds::sub_queue*> timed_out;
+	if (pub0.push(m, timed_out) || pub0.push(m, timed_out) || !timed_out.empty()) {
+		hogl::post(area, area->ERROR, "unexpected timeout");
+		return false;
+	}
+
+	auto t0 = std::chrono::steady_clock::now();
+	size_t n = pub0.push(m, timed_out);
+	auto dt = std::chrono::steady_clock::now() - t0;
+
+	if (n != 1 || timed_out.size() != 1 || timed_out[0] != sub0.queue() || dt < qos.max_blocking) {
+		hogl::post(area, area->ERROR, "unexpected timeout result %u (%u)", n, timed_out.size());
+		return false;
+	}
+	if (sub0.queue()->drop_count() != 1 || sub1.queue()->drop_count() != 1) {
+		hogl::post(area, area->ERROR, "unexpected drop counts");
+		return false;
+	}
+
+	// Reliable queues must drop the newest data
+	qos.history = vdds::sub_qos::history_policy::keep_last;
+	try {
+		vdds::sub<rel_msg> sub2(vd, "sub2", "/test/reliable", 2, nullptr, qos);
+		hogl::post(area, area->ERROR, "reliable keep_last subscriber created");
+		return false;
+	} catch (const std::logic_error&) {}
+
+	return true;
+}
+
+// Batch push with several blocked queues and filtered runs shares one deadline
+static bool run_batch_deadline_test()
+{
+	hogl::post(area, area->INFO, "batch deadline test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::sub_qos qos;
+	qos.reliability  = vdds::sub_qos::reliability_policy::reliable;
+	qos.max_blocking = std::chrono::milliseconds(50);
+
+	// Queues are never drained, every run of every queue times out
+	auto even = [](const rel_msg& m) { return m.count() % 2 == 0; };
+	vdds::sub<rel_msg> sub0(vd, "sub0", "/test/reliable-batch", 1, nullptr, qos);
+	vdds::sub<rel_msg> sub1(vd, "sub1", "/test/reliable-batch", 1, nullptr, qos);
+	vdds::sub<rel_msg> sub2(vd, "sub2", "/test/reliable-batch", even, 1, nullptr, qos);
+	vdds::pub<rel_msg> pub0(vd, "pub0", "/test/reliable-batch");
+
+	rel_msg batch[8];
+	for (unsigned int i=0; i<8; i++) batch[i].count() = i;
+
+	// Five waits (two queues, three filtered runs) if each computed its own deadline
+	auto t0 = std::chrono::steady_clock::now();
+	size_t n = pub0.push_batch(batch, 8);
+	auto dt = std::chrono::steady_clock::now() - t0;
+
+	hogl::post(area, area->INFO, "batch push blocked for %llu usec",
+			std::chrono::duration_cast<std::chrono::microseconds>(dt).count());
+
+	if (n != 3 || dt < qos.max_blocking || dt >= qos.max_blocking * 4) {
+		hogl::post(area, area->ERROR, "unexpected batch result %u blocked %llu usec", n,
+				std::chrono::duration_cast<std::chrono::microseconds>(dt).count());
+		return false;
+	}
+
+	return true;
+}
+
+bool run_test()
+{
+	if (!run_timeout_test())
+		return false;
+
+	if (!run_batch_deadline_test())
+		return false;
+
+	vdds::sub_qos qos;
+	const char* names[] = { "spin", "yield", "wait" };
+	vdds::sub_qos::backpressure modes[] = {
+		vdds::sub_qos::backpressure::spin,
+		vdds::sub_qos::backpressure::yield,
+		vdds::sub_qos::backpressure::wait };
+
+	for (unsigned int i=0; i<3; i++) {
+		qos.wait = modes[i];
+
+		qos.multi_pub = vdds::sub_qos::mpub::lock;
+		if (!run_lossless_test(fmt::format("lock-{}", names[i]).c_str(), qos))
+			return false;
+
+		qos.multi_pub = vdds::sub_qos::mpub::lockfree;
+		if (!run_lossless_test(fmt::format("lockfree-{}", names[i]).c_str(), qos))
+			return false;
+
+		qos.multi_pub = vdds::sub_qos::mpub::lanes;
+		if (!run_lossless_test(fmt::format("lanes-{}", names[i]).c_str(), qos))
+			return false;
+	}
+
+	return true;
+}
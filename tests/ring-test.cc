@@ -0,0 +1,225 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Broadcast ring topic test
+
+struct ring_msg : vdds::data {
+	static const char* data_type;
+
+	struct payload_t {
+		uint64_t pub_id;
+		uint64_t count;
+		uint64_t check[8];
+	};
+
+	payload_t* payload() { return reinterpret_cast<payload_t*>(&this->plain); }
+	const payload_t* payload() const { return reinterpret_cast<const payload_t*>(&this->plain); }
+
+	void fill(uint64_t id, uint64_t n)
+	{
+		auto p = payload();
+		p->pub_id = id;
+		p->count  = n;
+		for (auto &c : p->check) c = id ^ n;
+	}
+
+	bool valid() const
+	{
+		auto p = payload();
+		for (auto &c : p->check) { if (c != (p->pub_id ^ p->count)) return false; }
+		return true;
+	}
+};
+const char* ring_msg::data_type = "vdds.test.ring";
+
+static bool run_basic_test()
+{
+	hogl::post(area, area->INFO, "basic test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::topic_qos qos;
+	qos.ring_depth = 8;
+	vd.create_topic("/test/ring", ring_msg::data_type, qos);
+
+	vdds::pub<ring_msg> pub0(vd, "pub0", "/test/ring");
+	vdds::sub<ring_msg> sub0(vd, "sub0", "/test/ring");
+	vdds::sub<ring_msg> sub1(vd, "sub1", "/test/ring");
+
+	// Within the ring depth, everything is delivered to all subs
+	for (unsigned int i=0; i<4; i++) {
+		ring_msg m; m.timestamp = i; m.fill(0, i);
+		pub0.push(m);
+	}
+
+	for (auto s : { &sub0, &sub1 }) {
+		ring_msg m;
+		for (unsigned int i=0; i<4; i++) {
+			if (!s->pop(m) || m.seqno != i || !m.valid()) {
+				hogl::post(area, area->ERROR, "%s: missing or invalid data %u", s->name(), i);
+				return false;
+			}
+		}
+		if (s->pop(m)) {
+			hogl::post(area, area->ERROR, "%s: unexpected data", s->name());
+			return false;
+		}
+	}
+
+	// Overrun the ring. Late sub starts at the current head.
+	vdds::sub<ring_msg> sub2(vd, "sub2", "/test/ring");
+
+	for (unsigned int i=4; i<24; i++) {
+		ring_msg m; m.timestamp = i; m.fill(0, i);
+		pub0.push(m);
+	}
+
+	ring_msg m;
+	unsigned int n = 0;
+	while (sub0.pop(m)) {
+		if (m.seqno != 16 + n || !m.valid()) {
+			hogl::post(area, area->ERROR, "sub0: unexpected seqno %llu", m.seqno);
+			return false;
+		}
+		n++;
+	}
+	if (n != 8 || sub0.queue()->drop_count() != 12) {
+		hogl::post(area, area->ERROR, "sub0: popped %u lag %u", n, sub0.queue()->drop_count());
+		return false;
+	}
+	if (sub2.queue()->push_count() != 20 || sub2.queue()->size() != 8) {
+		hogl::post(area, area->ERROR, "sub2: push-count %u size %u", sub2.queue()->push_count(), sub2.queue()->size());
+		return false;
+	}
+
+	vd.dump();
+	return true;
+}
+
+// Multi-publisher, multi-subscriber stress
+static bool run_stress_test()
+{
+	hogl::post(area, area->INFO, "stress test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::topic_qos qos;
+	qos.ring_depth = 64;
+	vd.create_topic("/test/ring", ring_msg::data_type, qos);
+
+	static const unsigned int n_pubs = 2;
+	static const unsigned int n_subs = 3;
+	static const unsigned int n_msgs = 100000;
+
+	std::atomic_bool failed(false);
+	std::atomic_bool done(false);
+
+	std::vector<std::thread> sthreads;
+	std::vector<std::unique_ptr<vdds::notifier_cv>> nfs;
+	std::vector<std::unique_ptr<vdds::sub<ring_msg>>> subs;
+	for (unsigned int i=0; i<n_subs; i++) {
+		nfs.push_back(std::make_unique<vdds::notifier_cv>());
+		subs.push_back(std::make_unique<vdds::sub<ring_msg>>(vd, fmt::format("sub{}", i), "/test/ring", 0, nfs[i].get()));
+	}
+
+	std::vector<uint64_t> popped(n_subs, 0);
+
+	for (unsigned int i=0; i<n_subs; i++) {
+		sthreads.push_back(std::thread([&, i]() {
+			auto& s = *subs[i];
+			uint64_t last = 0;
+			bool first = true;
+			auto drain = [&]() {
+				ring_msg m;
+				while (s.pop(m)) {
+					if (!m.valid() || (!first && m.seqno <= last)) {
+						hogl::post(area, area->ERROR, "sub%u: invalid data seqno %llu last %llu", i, m.seqno, last);
+						failed = true;
+					}
+					first = false;
+					last = m.seqno;
+					popped[i]++;
+				}
+			};
+			while (!done) {
+				nfs[i]->wait_for(std::chrono::milliseconds(10));
+				drain();
+			}
+			drain();
+		}));
+	}
+
+	std::vector<std::thread> pthreads;
+	for (unsigned int i=0; i<n_pubs; i++) {
+		pthreads.push_back(std::thread([&, i]() {
+			vdds::pub<ring_msg> p(vd, fmt::format("pub{}", i), "/test/ring");
+			for (unsigned int n=0; n<n_msgs; n++) {
+				ring_msg m; m.timestamp = n; m.fill(i, n);
+				p.push(m);
+			}
+		}));
+	}
+
+	for (auto &t : pthreads) t.join();
+	done = true;
+	for (auto &t : sthreads) t.join();
+
+	vd.dump();
+
+	for (unsigned int i=0; i<n_subs; i++) {
+		auto q = subs[i]->queue();
+		if (popped[i] + q->drop_count() != n_pubs * n_msgs) {
+			hogl::post(area, area->ERROR, "sub%u: popped %llu lag %u expected total %u",
+					i, popped[i], q->drop_count(), n_pubs * n_msgs);
+			failed = true;
+		}
+	}
+
+	return !failed;
+}
+
+bool run_test()
+{
+	if (!run_basic_test())
+		return false;
+
+	if (!run_stress_test())
+		return false;
+
+	return true;
+}
@@ -34,9 +34,12 @@
 
 #include <boost/lockfree/queue.hpp>
 #include <vector>
+#include <new>
 
 #include "test-skell.hpp"
 
+#include <hogl/fmt/format.h>
+
 // Shared buffer for use with vdds
 struct shared_buffer : vdds::data::shared_t {
 	uint64_t dma_handle; // opaque DMA handle
@@ -218,7 +221,148 @@ dmabuf::dmabuf(dma_pool* p) : pool(p)
 	this->data = hb->data;
 }
 
-bool run_test()
+// Intrusive DMA buffer.
+// Same as dmabuf but keeps the reference count in the object, no shared_ptr control block.
+struct intrusive_dmabuf : vdds::data::intrusive_t
+{
+	dma_pool *pool;   // dmapool that owns the buffer
+	uint16_t  id;     // buffer ID
+	uint64_t  dma_handle;
+
+	intrusive_dmabuf(dma_pool *p, uint16_t i) : pool(p), id(i), dma_handle(p->id_to_hwbuf(i)->handle) {}
+
+	// Create buffer in place of the pool SW buffer
+	static intrusive_dmabuf* alloc(dma_pool& p)
+	{
+		uint16_t id;
+		if (!p.alloc(id)) return nullptr;
+		return new (p.id_to_swbuf(id, sizeof(intrusive_dmabuf))) intrusive_dmabuf(&p, id);
+	}
+
+	// Return the buffer to the pool once the last reference is dropped
+	void dispose() noexcept override
+	{
+		dma_pool* p = pool;
+		uint16_t  i = id;
+		this->~intrusive_dmabuf();
+		p->free(i);
+	}
+};
+
+// Test data type with intrusive buffer
+struct intrusive_data : vdds::data {
+	static const char* data_type;
+
+	intrusive_dmabuf* buffer() { return static_cast<intrusive_dmabuf *>(this->shared.get()); }
+};
+const char* intrusive_data::data_type = "vdds.test.intrusive-data";
+
+static bool run_intrusive_test(const std::string& mode, const vdds::topic_qos& tqos)
+{
+	hogl::post(area, area->INFO, "intrusive test: %s", mode);
+
+	static unsigned int const n_bufs = 4;
+	static unsigned int const n_subs = 5;
+
+	dma_pool pool("framebuf", n_bufs, 4*1024);
+
+	vdds::domain vd("DEFAULT");
+	vd.create_topic("/test/topic-I", intrusive_data::data_type, tqos);
+
+	vdds::pub<intrusive_data> pub0(vd, "pub0", "/test/topic-I");
+	std::vector<std::unique_ptr<vdds::sub<intrusive_data>>> subs;
+	for (unsigned int i=0; i<n_subs; i++)
+		subs.emplace_back(new vdds::sub<intrusive_data>(vd, fmt::format("sub{}", i), "/test/topic-I"));
+
+	// Cycle through the buffers several times, buffers must be returned to the pool
+	for (unsigned int i=0; i<n_bufs * 4; i++) {
+		{
+			auto b = intrusive_dmabuf::alloc(pool);
+			if (!b) {
+				hogl::post(area, area->ERROR, "%s: dma pool exhausted at %u", mode, i);
+				return false;
+			}
+
+			intrusive_data d;
+			d.shared = vdds::shared_handle(b);
+			pub0.push(d);
+
+			// Publisher copy and one reference per queue (or the ring slot)
+			long expected = 1 + (tqos.ring_depth ? 1 : n_subs);
+			if (d.shared.use_count() != expected) {
+				hogl::post(area, area->ERROR, "%s: incorrect use-count %u expected %u", mode, d.shared.use_count(), expected);
+				return false;
+			}
+		}
+
+		for (auto &s : subs) {
+			intrusive_data d;
+			if (!s->pop(d) || !d.buffer() || d.buffer()->dma_handle != pool.id_to_hwbuf(d.buffer()->id)->handle) {
+				hogl::post(area, area->ERROR, "%s: %s invalid buffer", mode, s->name());
+				return false;
+			}
+		}
+	}
+
+	vd.dump();
+	return true;
+}
+
+// Copies made by the content filters during the fan-out take their own references,
+// references added for the queues that rejected the data are dropped
+static bool run_fanout_test()
+{
+	hogl::post(area, area->INFO, "fan-out test");
+
+	dma_pool pool("framebuf", 1, 4*1024);
+
+	vdds::domain vd("DEFAULT");
+
+	std::vector<vdds::shared_handle> kept;
+	auto keep = [&](const intrusive_data& d) { kept.push_back(d.shared); return false; };
+
+	vdds::pub<intrusive_data> pub0(vd, "pub0", "/test/topic-P");
+	vdds::sub<intrusive_data> sub0(vd, "sub0", "/test/topic-P");
+	vdds::sub<intrusive_data> sub1(vd, "sub1", "/test/topic-P");
+	vdds::sub<intrusive_data> sub2(vd, "sub2", "/test/topic-P", keep);
+
+	for (unsigned int i=0; i<4; i++) {
+		auto b = intrusive_dmabuf::alloc(pool);
+		if (!b) {
+			hogl::post(area, area->ERROR, "buffer %u was not returned to the pool", i);
+			return false;
+		}
+
+		intrusive_data d;
+		d.shared = vdds::shared_handle(b);
+		pub0.push(d);
+
+		// Publisher copy, two queues and the filter copy
+		if (d.shared.use_count() != 4) {
+			hogl::post(area, area->ERROR, "incorrect use-count %u expected 4", d.shared.use_count());
+			return false;
+		}
+		kept.clear();
+
+		// std::shared_ptr view holds a reference
+		auto sp = d.shared.to_shared_ptr<intrusive_dmabuf>();
+		if (sp.get() != b || d.shared.use_count() != 4) {
+			hogl::post(area, area->ERROR, "invalid shared_ptr view: use-count %u", d.shared.use_count());
+			return false;
+		}
+		sp.reset();
+
+		intrusive_data r;
+		if (!sub0.pop(r) || !sub1.pop(r) || sub2.pop(r)) {
+			hogl::post(area, area->ERROR, "unexpected queue state");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool run_shared_ptr_test()
 {
 	hogl::post(area, area->INFO, "Starting test");
 
@@ -280,9 +424,36 @@ bool run_test()
 			hogl::post(area, area->ERROR, "incorrect use-count %u expected 5", d.shared.use_count());
 			return false;
 		}
+
+		// std::shared_ptr payloads are returned as is
+		auto sp = d.shared.to_shared_ptr<dmabuf>();
+		if (sp.get() != d.buffer() || d.shared.use_count() != 6) {
+			hogl::post(area, area->ERROR, "invalid shared_ptr view: use-count %u", d.shared.use_count());
+			return false;
+		}
 	}
 
 	hogl::post(area, area->INFO, "sizeof(vdds::data)) %u", sizeof(vdds::data));
 
 	return true;
 }
+
+bool run_test()
+{
+	if (!run_shared_ptr_test())
+		return false;
+
+	if (!run_intrusive_test("fifo", vdds::topic_qos()))
+		return false;
+
+	if (!run_fanout_test())
+		return false;
+
+	// Ring slots keep their reference until they are overwritten
+	vdds::topic_qos tqos;
+	tqos.ring_depth = 2;
+	if (!run_intrusive_test("ring", tqos))
+		return false;
+
+	return true;
+}
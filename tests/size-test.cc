@@ -0,0 +1,198 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Data size classes test
+
+struct tick_msg : vdds::data64 {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* tick_msg::data_type = "vdds.test.tick";
+
+struct frame_msg : vdds::data4k {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+	uint8_t& last() { return this->plain[this->plain.size() - 1]; }
+};
+const char* frame_msg::data_type = "vdds.test.frame";
+
+struct plain_tick_msg : vdds::plain64 {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* plain_tick_msg::data_type = "vdds.test.plain-tick";
+
+struct plain_frame_msg : vdds::plain1k {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* plain_frame_msg::data_type = "vdds.test.plain-frame";
+
+static_assert(sizeof(vdds::data::plain) == 224, "unexpected data plain size");
+static_assert(sizeof(tick_msg) == 64, "unexpected tick size");
+static_assert(sizeof(plain_tick_msg) == 64, "unexpected plain tick size");
+static_assert(std::is_trivially_copyable<plain_frame_msg>::value, "plain frame must be trivially copyable");
+static_assert(sizeof(frame_msg) == 4096, "unexpected frame size");
+
+template<typename T>
+static bool run_class_test(const std::string& mode, const vdds::topic_qos& tqos, const vdds::sub_qos& qos)
+{
+	hogl::post(area, area->INFO, "%s size %u mode %s", T::data_type, sizeof(T), mode);
+
+	vdds::domain vd("DEFAULT");
+	vd.create_topic<typename T::slot_type>("/test/size", T::data_type, tqos);
+
+	vdds::sub<T> sub0(vd, "sub0", "/test/size", 16, nullptr, qos);
+	vdds::pub<T> pub0(vd, "pub0", "/test/size");
+	vdds::pub<T> pub1(vd, "pub1", "/test/size");
+
+	for (unsigned int i=0; i<8; i++) {
+		T m; m.count() = i;
+		(i & 1 ? pub1 : pub0).push(m);
+	}
+
+	T b[4];
+	for (unsigned int i=0; i<4; i++) b[i].count() = 8 + i;
+	pub0.push_batch(b, 4);
+
+	T m;
+	for (unsigned int i=0; i<12; i++) {
+		if (!sub0.pop(m) || m.count() != i || m.seqno != i) {
+			hogl::post(area, area->ERROR, "%s: unexpected count %llu seqno %llu at %u", mode, m.count(), m.seqno, i);
+			return false;
+		}
+	}
+	if (sub0.pop(m)) {
+		hogl::post(area, area->ERROR, "%s: unexpected data", mode);
+		return false;
+	}
+
+	vdds::query::domain_info di;
+	vd.query(di);
+	if (di.topics[0].slot_size != sizeof(T)) {
+		hogl::post(area, area->ERROR, "%s: unexpected slot size %u", mode, di.topics[0].slot_size);
+		return false;
+	}
+
+	vd.dump();
+	return true;
+}
+
+template<typename T>
+static bool run_class_test()
+{
+	vdds::topic_qos tqos;
+	vdds::sub_qos qos;
+
+	if (!run_class_test<T>("fifo", tqos, qos))
+		return false;
+
+	qos.multi_pub = vdds::sub_qos::mpub::lockfree;
+	if (!run_class_test<T>("mpsc", tqos, qos))
+		return false;
+
+	qos.multi_pub = vdds::sub_qos::mpub::lanes;
+	qos.order = vdds::sub_qos::lane_order::seqno;
+	if (!run_class_test<T>("lanes", tqos, qos))
+		return false;
+
+	qos = vdds::sub_qos();
+	tqos.pool_size = 32;
+	if (!run_class_test<T>("pool", tqos, qos))
+		return false;
+
+	tqos = vdds::topic_qos();
+	tqos.ring_depth = 16;
+	if (!run_class_test<T>("ring", tqos, qos))
+		return false;
+
+	return true;
+}
+
+// Payloads use the whole size class, topics are bound to the size class
+static bool run_mixed_test()
+{
+	hogl::post(area, area->INFO, "mixed test");
+
+	vdds::domain vd("DEFAULT");
+
+	vdds::sub<frame_msg> sub0(vd, "sub0", "/test/frame");
+	vdds::pub<frame_msg> pub0(vd, "pub0", "/test/frame");
+
+	frame_msg f; f.count() = 1; f.last() = 0xa5;
+	pub0.push(f);
+
+	frame_msg r;
+	if (!sub0.pop(r) || r.count() != 1 || r.last() != 0xa5) {
+		hogl::post(area, area->ERROR, "frame payload mismatch");
+		return false;
+	}
+
+	// Same name and data type but a different size class
+	if (vd.create_topic<vdds::data>("/test/frame", frame_msg::data_type) ||
+			vd.create_topic<vdds::plain4k>("/test/frame", frame_msg::data_type)) {
+		hogl::post(area, area->ERROR, "size class mismatch not detected");
+		return false;
+	}
+
+	return true;
+}
+
+bool run_test()
+{
+	if (!run_class_test<tick_msg>())
+		return false;
+
+	if (!run_class_test<frame_msg>())
+		return false;
+
+	if (!run_class_test<plain_tick_msg>())
+		return false;
+
+	if (!run_class_test<plain_frame_msg>())
+		return false;
+
+	if (!run_mixed_test())
+		return false;
+
+	return true;
+}
@@ -0,0 +1,201 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/buffer-pool.hpp"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Topic scale test.
+// Tracks create and lookup cost as the number of topics in the domain grows,
+// and runs queries concurrently with topic creation.
+
+struct scale_msg : vdds::data {
+	static const char* data_type;
+};
+const char* scale_msg::data_type = "vdds.test.scale";
+
+static const unsigned int max_topics = 4096;
+
+static std::string topic_name(unsigned int i)
+{
+	// Long common prefix, typical for real topic trees
+	return fmt::format("/test/scale/sensors/node-{}/output-{}", i % 64, i);
+}
+
+static bool run_scale_test()
+{
+	hogl::post(area, area->INFO, "scale test");
+
+	vdds::domain vd("DEFAULT");
+
+	using clock = std::chrono::steady_clock;
+	using nsec  = std::chrono::nanoseconds;
+
+	std::vector<std::string> names;
+	std::vector<vdds::topic*> topics;
+	names.reserve(max_topics);
+	topics.reserve(max_topics);
+	for (unsigned int i=0; i<max_topics; i++)
+		names.push_back(topic_name(i));
+
+	// Create cost per step
+	std::vector<uint64_t> create_cost;
+
+	unsigned int n = 0;
+	for (unsigned int step = 256; step <= max_topics; step *= 2) {
+		// Create new topics up to the step size
+		unsigned int n0 = n;
+		auto t0 = clock::now();
+		for (; n < step; n++) {
+			auto t = vd.create_topic(names[n], scale_msg::data_type);
+			if (!t) {
+				hogl::post(area, area->ERROR, "failed to create topic %s", names[n]);
+				return false;
+			}
+			topics.push_back(t);
+		}
+		uint64_t create_ns = std::chrono::duration_cast<nsec>(clock::now() - t0).count() / (n - n0);
+		create_cost.push_back(create_ns);
+
+		// Lookup all existing topics
+		t0 = clock::now();
+		for (unsigned int i=0; i < n; i++) {
+			if (vd.create_topic(names[i], scale_msg::data_type) != topics[i]) {
+				hogl::post(area, area->ERROR, "lookup of topic %s returned wrong topic", names[i]);
+				return false;
+			}
+		}
+		auto lookup_ns = std::chrono::duration_cast<nsec>(clock::now() - t0).count() / n;
+
+		hogl::post(area, area->INFO, "ntopics %u create %llu nsec/op lookup %llu nsec/op", n, create_ns, lookup_ns);
+	}
+
+	// Create cost should not grow with the number of topics (linear cost per create would
+	// be 16x from the first to the last step). Timings are too noisy to fail on, logged only.
+	hogl::post(area, area->INFO, "create cost %llu nsec/op (first step) %llu nsec/op (last step)",
+			create_cost.front(), create_cost.back());
+
+	// Existing topic with mismatched data type must still be rejected
+	if (vd.create_topic(names[max_topics / 2], "vdds.test.other")) {
+		hogl::post(area, area->ERROR, "data-type mismatch not detected");
+		return false;
+	}
+
+	vdds::query::domain_info di;
+	vd.query(di);
+	if (di.topics.size() != max_topics) {
+		hogl::post(area, area->ERROR, "unexpected number of topics %u", di.topics.size());
+		return false;
+	}
+
+	// Topics are listed in creation order (across the topic list chunks)
+	for (unsigned int i=0; i<max_topics; i++) {
+		if (di.topics[i].name != names[i]) {
+			hogl::post(area, area->ERROR, "topic %u: unexpected name %s expected %s", i, di.topics[i].name, names[i]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool run_concurrent_test()
+{
+	hogl::post(area, area->INFO, "concurrent test");
+
+	vdds::domain vd("DEFAULT");
+
+	const unsigned int n_topics = 1024;
+
+	std::atomic_bool done(false);
+	std::atomic_bool failed(false);
+	uint64_t n_queries = 0;
+
+	// Monitoring thread, the number of topics seen by the queries must never go down
+	std::thread qthread([&]() {
+		vdds::query::domain_info di;
+		size_t last = 0;
+		while (!done) {
+			vd.query(di);
+			vd.kick();
+			if (di.topics.size() < last) {
+				hogl::post(area, area->ERROR, "query returned %u topics, previous query %u", di.topics.size(), last);
+				failed = true;
+			}
+			last = di.topics.size();
+			n_queries++;
+		}
+	});
+
+	for (unsigned int i=0; i<n_topics; i++) {
+		if (!vd.create_topic(topic_name(i), scale_msg::data_type)) {
+			hogl::post(area, area->ERROR, "failed to create topic %s", topic_name(i));
+			failed = true;
+			break;
+		}
+
+		// Pools come and go while the queries are running
+		if (i % 64 == 0) {
+			vdds::buffer_pool bp(vd, fmt::format("pool-{}", i), 16, 256);
+			std::this_thread::yield();
+		}
+	}
+
+	done = true;
+	qthread.join();
+
+	vdds::query::domain_info di;
+	vd.query(di);
+	if (di.topics.size() != n_topics || !di.pools.empty()) {
+		hogl::post(area, area->ERROR, "unexpected number of topics %u pools %u", di.topics.size(), di.pools.size());
+		return false;
+	}
+
+	hogl::post(area, area->INFO, "queries %llu", n_queries);
+
+	return !failed;
+}
+
+bool run_test()
+{
+	if (!run_scale_test())
+		return false;
+	if (!run_concurrent_test())
+		return false;
+	return true;
+}
@@ -0,0 +1,147 @@
+//  Copyright (c) 2026, Qualcomm Innovation Center, Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//  2. Redistributions in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//  3. Neither the name of the copyright holder nor the names of its contributors
+//     may be used to endorse or promote products derived from this software
+//     without specific prior written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+//  POSSIBILITY OF SUCH DAMAGE.
+//
+//  SPDX-License-Identifier: BSD-3-Clause
+
+#include "vdds/domain.hpp"
+#include "vdds/pub.hpp"
+#include "vdds/sub.hpp"
+#include "vdds/waitset.hpp"
+
+#include <thread>
+#include <atomic>
+
+#include "test-skell.hpp"
+
+#include <hogl/fmt/format.h>
+
+// Waitset test
+
+struct input_msg : vdds::data64 {
+	static const char* data_type;
+
+	uint64_t& count() { return *reinterpret_cast<uint64_t*>(&this->plain); }
+};
+const char* input_msg::data_type = "vdds.test.input";
+
+static const unsigned int n_inputs = 30;
+static const unsigned int n_msgs   = 20000;
+
+bool run_test()
+{
+	vdds::domain vd("DEFAULT");
+	vdds::waitset ws(n_inputs);
+
+	// Fusion node with many inputs, member ids match the input index
+	using input_sub = vdds::sub<input_msg>;
+	std::vector<std::unique_ptr<input_sub>> subs;
+	for (unsigned int i=0; i<n_inputs; i++) {
+		auto m = ws.add();
+		if (!m || m->id() != i) {
+			hogl::post(area, area->ERROR, "failed to add waitset member %u", i);
+			return false;
+		}
+		subs.emplace_back(new input_sub(vd, "fusion", fmt::format("/test/input/{}", i), 256, m));
+	}
+
+	if (ws.add()) {
+		hogl::post(area, area->ERROR, "waitset capacity is not enforced");
+		return false;
+	}
+
+	std::vector<std::unique_ptr<vdds::pub<input_msg>>> pubs;
+	for (unsigned int i=0; i<n_inputs; i++)
+		pubs.emplace_back(new vdds::pub<input_msg>(vd, "source", fmt::format("/test/input/{}", i)));
+
+	std::atomic_bool done(false);
+	std::thread pthread([&]() {
+		// Spread the data over the inputs unevenly
+		for (unsigned int n=0; n<n_msgs; n++) {
+			unsigned int i = (n * 7 + n / 3) % n_inputs;
+			input_msg m; m.count() = n;
+			pubs[i]->push(m);
+			if (n % 64 == 0) std::this_thread::yield();
+		}
+		done = true;
+	});
+
+	uint64_t popped = 0, wakeups = 0, empty_pops = 0;
+	std::vector<uint64_t> last(n_inputs, 0);
+	std::vector<unsigned int> ready;
+	bool failed = false;
+
+	auto drops = [&]() { uint64_t d = 0; for (auto &s : subs) d += s->queue()->drop_count(); return d; };
+
+	while (popped + drops() < n_msgs) {
+		if (!ws.wait(ready, std::chrono::seconds(10))) {
+			if (done) {
+				hogl::post(area, area->ERROR, "waitset missed ready queues");
+				failed = true;
+				break;
+			}
+			continue;
+		}
+		wakeups++;
+
+		for (auto i : ready) {
+			input_msg m;
+			unsigned int n = 0;
+			for (; subs[i]->pop(m); n++) {
+				if (m.count() < last[i]) {
+					hogl::post(area, area->ERROR, "input %u: out of order count %llu", i, m.count());
+					failed = true;
+				}
+				last[i] = m.count();
+			}
+			popped += n;
+			empty_pops += !n;
+		}
+	}
+
+	pthread.join();
+
+	hogl::post(area, area->INFO, "popped %llu drops %llu wakeups %llu empty-pops %llu", popped, drops(), wakeups, empty_pops);
+
+	// Without the waitset each wakeup would pop all inputs
+	if (empty_pops > wakeups) {
+		hogl::post(area, area->ERROR, "too many empty pops %llu (wakeups %llu)", empty_pops, wakeups);
+		failed = true;
+	}
+
+	// Shutdown marks the members ready and overrides the timeout
+	vd.shutdown(std::chrono::milliseconds(1));
+	auto t0 = std::chrono::steady_clock::now();
+	ws.wait(ready, std::chrono::seconds(10));
+	ws.wait(ready, std::chrono::seconds(10));
+	if (std::chrono::steady_clock::now() - t0 > std::chrono::seconds(1)) {
+		hogl::post(area, area->ERROR, "waitset ignores shutdown");
+		failed = true;
+	}
+
+	return !failed;
+}